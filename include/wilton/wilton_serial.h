@@ -33,31 +33,255 @@ extern "C" {
 struct wilton_Serial;
 typedef struct wilton_Serial wilton_Serial;
 
+struct wilton_SerialSubscription;
+typedef struct wilton_SerialSubscription wilton_SerialSubscription;
+
 char* wilton_Serial_open(
         wilton_Serial** ser_out,
         const char* conf,
         int conf_len);
 
+char* wilton_Serial_open_profile(
+        wilton_Serial** ser_out,
+        const char* profile,
+        int profile_len,
+        const char* port,
+        int port_len);
+
+char* wilton_Serial_register_profile(
+        const char* name,
+        int name_len,
+        const char* conf,
+        int conf_len);
+
+char* wilton_Serial_unregister_profile(
+        const char* name,
+        int name_len);
+
 char* wilton_Serial_read(
         wilton_Serial* ser,
         int len,
         char** data_out,
         int* data_len_out);
 
+char* wilton_Serial_read_into(
+        wilton_Serial* ser,
+        char* buf,
+        int cap,
+        int* len_out);
+
+char* wilton_Serial_read_timestamped(
+        wilton_Serial* ser,
+        int len,
+        int timeout_millis,
+        int strip_nul,
+        int mask_parity,
+        char** data_out,
+        int* data_len_out);
+
 char* wilton_Serial_readline(
         wilton_Serial* ser,
         char** data_out,
         int* data_len_len);
 
+char* wilton_Serial_readlines(
+        wilton_Serial* ser,
+        int max_lines,
+        int timeout_millis,
+        char** lines_json_out,
+        int* lines_json_len_out);
+
+char* wilton_Serial_read_nmea(
+        wilton_Serial* ser,
+        int max_sentences,
+        int timeout_millis,
+        char** result_out,
+        int* result_len_out);
+
+char* wilton_Serial_read_frames(
+        wilton_Serial* ser,
+        const char* framing,
+        int framing_len,
+        int max_frames,
+        int timeout_millis,
+        char** result_out,
+        int* result_len_out);
+
+char* wilton_Serial_read_many(
+        wilton_Serial** sers,
+        int sers_count,
+        const long long* keys,
+        int len,
+        int timeout_millis,
+        char** result_out,
+        int* result_len_out);
+
 char* wilton_Serial_write(
         wilton_Serial* ser,
         const char* data,
         int data_len,
         int* len_written_out);
 
+char* wilton_Serial_write_drain(
+        wilton_Serial* ser,
+        const char* data,
+        int data_len,
+        int* len_written_out);
+
+char* wilton_Serial_flush(
+        wilton_Serial* ser);
+
+char* wilton_Serial_drain(
+        wilton_Serial* ser);
+
+char* wilton_Serial_send_file(
+        wilton_Serial* ser,
+        const char* path,
+        int path_len,
+        int chunk_size,
+        int chunk_delay_millis,
+        int max_bytes,
+        int* len_written_out);
+
+char* wilton_Serial_receive_to_file(
+        wilton_Serial* ser,
+        const char* path,
+        int path_len,
+        int chunk_size,
+        int max_bytes,
+        const char* terminator,
+        int terminator_len,
+        int idle_timeout_millis,
+        int* len_read_out);
+
+char* wilton_Serial_xmodem_send(
+        wilton_Serial* ser,
+        const char* path,
+        int path_len,
+        const char* protocol,
+        int protocol_len,
+        int retries,
+        int timeout_millis,
+        void (*progress_cb)(void* ctx, long long bytes_done, long long bytes_total),
+        void* progress_ctx,
+        int* len_written_out);
+
+char* wilton_Serial_xmodem_receive(
+        wilton_Serial* ser,
+        const char* path,
+        int path_len,
+        const char* protocol,
+        int protocol_len,
+        int retries,
+        int timeout_millis,
+        void (*progress_cb)(void* ctx, long long bytes_done, long long bytes_total),
+        void* progress_ctx,
+        char** file_name_out,
+        int* file_name_len_out,
+        int* len_read_out);
+
+char* wilton_Serial_get_modem_lines(
+        wilton_Serial* ser,
+        char** lines_json_out,
+        int* lines_json_len_out);
+
+char* wilton_Serial_set_modem_line(
+        wilton_Serial* ser,
+        const char* line,
+        int line_len,
+        int value);
+
+char* wilton_Serial_send_break(
+        wilton_Serial* ser,
+        int duration_millis);
+
+char* wilton_Serial_wait_modem_change(
+        wilton_Serial* ser,
+        const char* lines,
+        int lines_len,
+        int timeout_millis,
+        int* changed_out);
+
+char* wilton_Serial_status(
+        wilton_Serial* ser,
+        char** status_json_out,
+        int* status_json_len_out);
+
 char* wilton_Serial_close(
         wilton_Serial* ser);
 
+char* wilton_Serial_poll_start(
+        wilton_Serial* ser,
+        const char* conf,
+        int conf_len);
+
+char* wilton_Serial_poll_results(
+        wilton_Serial* ser,
+        char** results_json_out,
+        int* results_json_len_out);
+
+char* wilton_Serial_poll_stop(
+        wilton_Serial* ser);
+
+char* wilton_Serial_watch_start(
+        wilton_Serial* ser,
+        const char* conf,
+        int conf_len);
+
+char* wilton_Serial_watch_wait(
+        wilton_Serial* ser,
+        int max_matches,
+        int timeout_millis,
+        char** result_out,
+        int* result_len_out);
+
+char* wilton_Serial_watch_stop(
+        wilton_Serial* ser);
+
+char* wilton_Serial_shm_start(
+        wilton_Serial* ser,
+        const char* conf,
+        int conf_len,
+        char** info_json_out,
+        int* info_json_len_out);
+
+char* wilton_Serial_shm_advance(
+        wilton_Serial* ser,
+        int len,
+        int timeout_millis,
+        long long* read_pos_out,
+        long long* write_pos_out);
+
+char* wilton_Serial_shm_stop(
+        wilton_Serial* ser);
+
+char* wilton_Serial_subscribe(
+        wilton_Serial* ser,
+        const char* overflow_policy,
+        int overflow_policy_len,
+        wilton_SerialSubscription** sub_out);
+
+char* wilton_SerialSubscription_read(
+        wilton_SerialSubscription* sub,
+        int len,
+        int timeout_millis,
+        char** data_out,
+        int* data_len_out);
+
+char* wilton_SerialSubscription_status(
+        wilton_SerialSubscription* sub,
+        char** status_json_out,
+        int* status_json_len_out);
+
+char* wilton_SerialSubscription_close(
+        wilton_SerialSubscription* sub);
+
+char* wilton_Serial_scan(
+        const char* conf,
+        int conf_len,
+        char** result_out,
+        int* result_len_out);
+
 #ifdef __cplusplus
 }
 #endif
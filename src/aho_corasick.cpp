@@ -0,0 +1,98 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   aho_corasick.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 07:08 PM
+ */
+
+#include "aho_corasick.hpp"
+
+#include <algorithm>
+#include <deque>
+
+#include "staticlib/support.hpp"
+
+#include "wilton/support/exception.hpp"
+
+namespace wilton {
+namespace serial {
+
+namespace { // anonymous
+
+const uint32_t no_state = static_cast<uint32_t>(-1);
+
+} // namespace
+
+aho_corasick::aho_corasick(const std::vector<std::string>& patterns) {
+    if (patterns.empty()) throw support::exception(TRACEMSG(
+            "Empty list of patterns specified"));
+    auto empty_row = std::array<uint32_t, 256>();
+    empty_row.fill(no_state);
+    transitions.push_back(empty_row);
+    outputs.emplace_back();
+    // trie
+    for (size_t idx = 0; idx < patterns.size(); idx++) {
+        auto& pa = patterns[idx];
+        if (pa.empty()) throw support::exception(TRACEMSG(
+                "Empty pattern specified, index: [" + sl::support::to_string(idx) + "]"));
+        uint32_t st = 0;
+        for (char ch : pa) {
+            auto byte = static_cast<uint8_t>(ch);
+            if (no_state == transitions[st][byte]) {
+                transitions[st][byte] = static_cast<uint32_t>(transitions.size());
+                transitions.push_back(empty_row);
+                outputs.emplace_back();
+            }
+            st = transitions[st][byte];
+        }
+        outputs[st].push_back(static_cast<uint32_t>(idx));
+        lengths.push_back(pa.length());
+        max_length = std::max(max_length, pa.length());
+    }
+    // failure links, missing transitions are taken from the failure state
+    auto fail = std::vector<uint32_t>(transitions.size(), 0);
+    auto queue = std::deque<uint32_t>();
+    for (size_t b = 0; b < 256; b++) {
+        uint32_t next = transitions[0][b];
+        if (no_state == next) {
+            transitions[0][b] = 0;
+        } else {
+            fail[next] = 0;
+            queue.push_back(next);
+        }
+    }
+    while (!queue.empty()) {
+        uint32_t st = queue.front();
+        queue.pop_front();
+        auto& fail_outputs = outputs[fail[st]];
+        outputs[st].insert(outputs[st].end(), fail_outputs.begin(), fail_outputs.end());
+        for (size_t b = 0; b < 256; b++) {
+            uint32_t next = transitions[st][b];
+            if (no_state == next) {
+                transitions[st][b] = transitions[fail[st]][b];
+            } else {
+                fail[next] = transitions[fail[st]][b];
+                queue.push_back(next);
+            }
+        }
+    }
+}
+
+} // namespace
+}
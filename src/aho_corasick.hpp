@@ -0,0 +1,91 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   aho_corasick.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 07:05 PM
+ */
+
+#ifndef WILTON_SERIAL_AHO_CORASICK_HPP
+#define WILTON_SERIAL_AHO_CORASICK_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+
+namespace wilton {
+namespace serial {
+
+/**
+ * Multi-pattern byte matcher, the automaton is built as a full
+ * transition table, so matching costs one lookup per input byte;
+ * matcher state is kept between the calls, patterns spanning
+ * the chunk boundaries are found
+ */
+class aho_corasick {
+    std::vector<std::array<uint32_t, 256>> transitions;
+    // pattern indices ending in each state, including the suffix ones
+    std::vector<std::vector<uint32_t>> outputs;
+    std::vector<size_t> lengths;
+    size_t max_length = 0;
+    uint32_t state = 0;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param patterns non-empty list of non-empty patterns
+     */
+    explicit aho_corasick(const std::vector<std::string>& patterns);
+
+    /**
+     * Matches the next chunk of the stream
+     *
+     * @param data input chunk
+     * @param on_match called with the pattern index and the position
+     *        in chunk right after the match end
+     */
+    template<typename Func>
+    void feed(sl::io::span<const char> data, Func on_match) {
+        uint32_t st = state;
+        for (size_t i = 0; i < data.size(); i++) {
+            st = transitions[st][static_cast<uint8_t>(data[i])];
+            for (uint32_t idx : outputs[st]) {
+                on_match(idx, i + 1);
+            }
+        }
+        state = st;
+    }
+
+    size_t pattern_length(uint32_t idx) const {
+        return lengths[idx];
+    }
+
+    size_t max_pattern_length() const {
+        return max_length;
+    }
+};
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_AHO_CORASICK_HPP */
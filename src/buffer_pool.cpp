@@ -0,0 +1,76 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   buffer_pool.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 05:10 PM
+ */
+
+#include "buffer_pool.hpp"
+
+namespace wilton {
+namespace serial {
+
+pooled_buffer::~pooled_buffer() STATICLIB_NOEXCEPT {
+    if (nullptr != pool) {
+        pool->release(std::move(data));
+    }
+}
+
+buffer_pool::buffer_pool(uint32_t max_buffers, size_t max_buffer_size) :
+max_buffers(max_buffers),
+max_buffer_size(max_buffer_size) {
+    free_list.reserve(max_buffers);
+}
+
+pooled_buffer buffer_pool::acquire(size_t size) {
+    std::string data;
+    if (size <= max_buffer_size) {
+        std::lock_guard<std::mutex> guard{mutex};
+        if (!free_list.empty()) {
+            // prefer the buffer that is already large enough,
+            // otherwise take the last one, it will grow and return
+            size_t idx = free_list.size() - 1;
+            for (size_t i = 0; i < free_list.size(); i++) {
+                if (free_list[i].capacity() >= size) {
+                    idx = i;
+                    break;
+                }
+            }
+            data = std::move(free_list[idx]);
+            free_list.erase(free_list.begin() + static_cast<std::ptrdiff_t>(idx));
+        }
+    }
+    // no-op for the recycled buffer of sufficient capacity
+    data.resize(size);
+    return pooled_buffer(*this, std::move(data));
+}
+
+void buffer_pool::release(std::string&& data) STATICLIB_NOEXCEPT {
+    if (data.capacity() > max_buffer_size) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard{mutex};
+    if (free_list.size() < max_buffers) {
+        // capacity is preserved by the move, free_list storage is reserved upfront
+        free_list.emplace_back(std::move(data));
+    }
+}
+
+} // namespace
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   buffer_pool.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 05:10 PM
+ */
+
+#ifndef WILTON_SERIAL_BUFFER_POOL_HPP
+#define WILTON_SERIAL_BUFFER_POOL_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+
+namespace wilton {
+namespace serial {
+
+class buffer_pool;
+
+/**
+ * Buffer borrowed from the pool, returned back on destruction
+ */
+class pooled_buffer {
+    buffer_pool* pool;
+    std::string data;
+
+public:
+    pooled_buffer(buffer_pool& pool, std::string&& data) :
+    pool(std::addressof(pool)),
+    data(std::move(data)) { }
+
+    pooled_buffer(const pooled_buffer&) = delete;
+
+    pooled_buffer& operator=(const pooled_buffer&) = delete;
+
+    pooled_buffer(pooled_buffer&& other) :
+    pool(other.pool),
+    data(std::move(other.data)) {
+        other.pool = nullptr;
+    }
+
+    pooled_buffer& operator=(pooled_buffer&&) = delete;
+
+    ~pooled_buffer() STATICLIB_NOEXCEPT;
+
+    sl::io::span<char> span() {
+        return {std::addressof(data.front()), data.length()};
+    }
+};
+
+/**
+ * Keeps the buffers released after the previous calls
+ * and hands them out again, so the steady-state reads
+ * with the same length do not allocate; large buffers
+ * are not kept, so a single large read does not pin its memory
+ */
+class buffer_pool {
+    friend class pooled_buffer;
+
+    std::mutex mutex;
+    std::vector<std::string> free_list;
+    uint32_t max_buffers;
+    size_t max_buffer_size;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param max_buffers max number of released buffers to keep,
+     *        zero disables pooling
+     * @param max_buffer_size larger buffers are allocated and freed
+     *        on each call
+     */
+    buffer_pool(uint32_t max_buffers, size_t max_buffer_size);
+
+    buffer_pool(const buffer_pool&) = delete;
+
+    buffer_pool& operator=(const buffer_pool&) = delete;
+
+    /**
+     * Borrows a buffer from the pool, allocates a new one
+     * if the pool is empty or the size is over the limit
+     *
+     * @param size buffer size, must be positive
+     * @return buffer of the specified size
+     */
+    pooled_buffer acquire(size_t size);
+
+private:
+    void release(std::string&& data) STATICLIB_NOEXCEPT;
+};
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_BUFFER_POOL_HPP */
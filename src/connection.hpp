@@ -24,12 +24,15 @@
 #ifndef WILTON_SERIAL_CONNECTION_HPP
 #define WILTON_SERIAL_CONNECTION_HPP
 
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "staticlib/config.hpp"
 #include "staticlib/io.hpp"
 #include "staticlib/pimpl.hpp"
 
+#include "modem_line.hpp"
 #include "serial_config.hpp"
 
 namespace wilton {
@@ -54,9 +57,111 @@ public:
 
     std::string read(uint32_t length);
 
+    uint32_t read_into(sl::io::span<char> buf);
+
+    /**
+     * Waits up to the specified timeout for incoming data, then returns
+     * without waiting for the buffer to be filled completely
+     *
+     * @param buf destination buffer
+     * @param timeout_millis max time to wait for the first bytes
+     * @return number of bytes read, zero on timeout
+     */
+    uint32_t read_available(sl::io::span<char> buf, uint32_t timeout_millis);
+
     std::string read_line();
 
     uint32_t write(sl::io::span<const char> data);
+
+    /**
+     * Passes the data queued for coalescing (if enabled) to the driver
+     */
+    void flush();
+
+    /**
+     * Flushes the queued data and waits until all the written data
+     * is transmitted by the driver
+     */
+    void drain();
+
+    /**
+     * Writes the data and waits until the last byte leaves the transmitter,
+     * for RS-485 switches the bus direction around the write
+     * if it is not done by the driver
+     *
+     * @param data data to write
+     * @return number of bytes written
+     */
+    uint32_t write_drain(sl::io::span<const char> data);
+
+    /**
+     * Returns the data back to the connection, it will be consumed
+     * by the subsequent reads before reading from the port
+     *
+     * @param data data to return
+     */
+    void unread(sl::io::span<const char> data);
+
+    /**
+     * Current state of the modem control lines
+     *
+     * @return object with boolean "DTR", "RTS", "CTS", "DSR", "DCD" and "RI" fields
+     */
+    sl::json::value modem_lines();
+
+    /**
+     * Raises or lowers the output modem line
+     *
+     * @param line DTR or RTS
+     * @param value true to raise the line
+     */
+    void set_modem_line(modem_line line, bool value);
+
+    /**
+     * Flushes the queued data and sends the break condition
+     *
+     * @param duration_millis break duration, driver default (0.25-0.5 sec) if zero
+     */
+    void send_break(uint32_t duration_millis);
+
+    /**
+     * Waits for the change of any of the specified input lines,
+     * can be called while the port is read in background
+     *
+     * @param lines input lines (CTS, DSR, DCD, RI) to watch
+     * @param timeout_millis max time to wait, connection timeout is used if zero
+     * @param io_mutex mutex that serializes the calls to the connection,
+     *        must not be held by the caller, it is taken for each poll of the lines
+     * @return true if line changed, false on timeout
+     */
+    bool wait_modem_change(const std::vector<modem_line>& lines, uint32_t timeout_millis,
+            std::mutex& io_mutex);
+
+    const serial_config& config() const;
+
+    /**
+     * Descriptor that becomes readable when the data arrives,
+     * allows to wait on multiple connections with a single poll
+     *
+     * @return port descriptor, -1 if the port is not open or on Windows
+     */
+    int poll_fd() const;
+
+    /**
+     * Whether the data returned with `unread` is pending,
+     * such data is not signalled by the `poll_fd`
+     *
+     * @return true if the next read will return the data immediately
+     */
+    bool has_unread() const;
+
+    /**
+     * Returns connection state: port, whether the device is currently open
+     * and the number of transparent reconnects performed so far
+     *
+     * @return status JSON
+     */
+    sl::json::value status() const;
 };
 
 } // namespace
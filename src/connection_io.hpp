@@ -0,0 +1,168 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   connection_io.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 11:05 AM
+ */
+
+#ifndef WILTON_SERIAL_CONNECTION_IO_HPP
+#define WILTON_SERIAL_CONNECTION_IO_HPP
+
+#include <ios>
+#include <string>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "wilton/support/exception.hpp"
+
+#include "connection.hpp"
+
+namespace wilton {
+namespace serial {
+
+/**
+ * Source adapter for the serial connection, returns the data
+ * as soon as it is available, reports EOF on timeout
+ */
+class connection_source {
+    connection& conn;
+    uint32_t timeout_millis;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param conn connection, must outlive this adapter
+     * @param timeout_millis max time to wait for the data on each read,
+     *        connection timeout is used if zero
+     */
+    explicit connection_source(connection& conn, uint32_t timeout_millis = 0) :
+    conn(conn),
+    timeout_millis(timeout_millis > 0 ? timeout_millis : conn.config().timeout_millis) { }
+
+    connection_source(const connection_source&) = delete;
+
+    connection_source& operator=(const connection_source&) = delete;
+
+    connection_source(connection_source&& other) :
+    conn(other.conn),
+    timeout_millis(other.timeout_millis) { }
+
+    connection_source& operator=(connection_source&&) = delete;
+
+    /**
+     * Reads available data into the specified buffer
+     *
+     * @param span destination buffer
+     * @return number of bytes read, EOF if no data arrived before the timeout
+     */
+    std::streamsize read(sl::io::span<char> span) {
+        if (0 == span.size()) {
+            return 0;
+        }
+        uint32_t read = conn.read_available(span, timeout_millis);
+        if (read > 0) {
+            return static_cast<std::streamsize>(read);
+        }
+        return std::char_traits<char>::eof();
+    }
+};
+
+/**
+ * Sink adapter for the serial connection, throws if no data
+ * can be written before the connection timeout
+ */
+class connection_sink {
+    connection& conn;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param conn connection, must outlive this adapter
+     */
+    explicit connection_sink(connection& conn) :
+    conn(conn) { }
+
+    connection_sink(const connection_sink&) = delete;
+
+    connection_sink& operator=(const connection_sink&) = delete;
+
+    connection_sink(connection_sink&& other) :
+    conn(other.conn) { }
+
+    connection_sink& operator=(connection_sink&&) = delete;
+
+    /**
+     * Writes specified data into the connection
+     *
+     * @param span source buffer
+     * @return number of bytes written
+     */
+    std::streamsize write(sl::io::span<const char> span) {
+        if (0 == span.size()) {
+            return 0;
+        }
+        uint32_t written = conn.write(span);
+        if (0 == written) throw support::exception(TRACEMSG(
+                "Serial write timeout, port: [" + conn.config().port + "],"
+                " bytes to write: [" + sl::support::to_string(span.size()) + "]"));
+        return static_cast<std::streamsize>(written);
+    }
+
+    /**
+     * Passes the data queued for coalescing (if enabled) to the driver
+     *
+     * @return zero
+     */
+    std::streamsize flush() {
+        conn.flush();
+        return 0;
+    }
+};
+
+/**
+ * Factory function for creating connection source
+ *
+ * @param conn connection, must outlive the returned source
+ * @param timeout_millis max time to wait for the data on each read,
+ *        connection timeout is used if zero
+ * @return connection source
+ */
+inline connection_source make_connection_source(connection& conn, uint32_t timeout_millis = 0) {
+    return connection_source(conn, timeout_millis);
+}
+
+/**
+ * Factory function for creating connection sink
+ *
+ * @param conn connection, must outlive the returned sink
+ * @return connection sink
+ */
+inline connection_sink make_connection_sink(connection& conn) {
+    return connection_sink(conn);
+}
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_CONNECTION_IO_HPP */
+
@@ -23,58 +23,252 @@
 
 #include "connection.hpp"
 
+#include <algorithm>
 #include <array>
 #include <chrono>
+#include <memory>
+#include <thread>
 
+#include <dirent.h>
 #include <fcntl.h>
 #include <poll.h>
+#include <sys/file.h>
+#include <sys/ioctl.h>
 #include <termios.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <linux/serial.h>
+#endif // __linux__
+#include <climits>
+#include <cstdlib>
 
 #include "staticlib/support.hpp"
 #include "staticlib/pimpl/forward_macros.hpp"
 #include "staticlib/utils.hpp"
 
+#include "modem_monitor.hpp"
+#include "probes.hpp"
+#include "tx_queue.hpp"
+#include "tx_timing.hpp"
+
 namespace wilton {
 namespace serial {
 
+namespace { // anonymous
+
+// retry interval while another process owns the port
+const std::chrono::milliseconds lock_retry_interval = std::chrono::milliseconds(10);
+
+void set_tty_mode(struct termios& tty) {
+    tty.c_cflag |= (CLOCAL | CREAD);
+
+    tty.c_lflag &= ~(ICANON | ECHO | ECHOE |
+            ECHOK | ECHONL |
+            ISIG | IEXTEN); // | ECHOPRT
+    tty.c_lflag &= ~ECHOCTL;
+    tty.c_lflag &= ~ECHOKE;
+
+    tty.c_oflag &= ~(OPOST | ONLCR | OCRNL);
+
+    tty.c_iflag &= ~(INLCR | IGNCR | ICRNL | IGNBRK);
+    tty.c_iflag &= ~IUCLC;
+    tty.c_iflag &= ~PARMRK;
+}
+
+void set_baud_rate(const serial_config& conf, struct termios& tty) {
+    speed_t rate = B0;
+    switch (conf.baud_rate) {
+    case 0: rate = B0; break;
+    case 50: rate = B50; break;
+    case 75: rate = B75; break;
+    case 110: rate = B110; break;
+    case 134: rate = B134; break;
+    case 150: rate = B150; break;
+    case 200: rate = B200; break;
+    case 300: rate = B300; break;
+    case 600: rate = B600; break;
+    case 1200: rate = B1200; break;
+    case 1800: rate = B1800; break;
+    case 2400: rate = B2400; break;
+    case 4800: rate = B4800; break;
+    case 9600: rate = B9600; break;
+    case 19200: rate = B19200; break;
+    case 38400: rate = B38400; break;
+    case 57600: rate = B57600; break;
+    case 115200: rate = B115200; break;
+    case 230400: rate = B230400; break;
+    case 460800: rate = B460800; break;
+    case 500000: rate = B500000; break;
+    case 576000: rate = B576000; break;
+    case 921600: rate = B921600; break;
+    default: throw support::exception(TRACEMSG(
+            "Invalid 'baudRate' specified: [" + sl::support::to_string(conf.baud_rate) + "]"));
+    }
+    auto err_o = ::cfsetospeed(std::addressof(tty), rate);
+    if (0 != err_o) {
+        throw support::exception(TRACEMSG(
+            "Serial 'cfsetospeed' error, baudrate: [" + sl::support::to_string(conf.baud_rate) + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+    }
+    auto err_i = ::cfsetispeed(std::addressof(tty), rate);
+    if (0 != err_i) {
+        throw support::exception(TRACEMSG(
+            "Serial 'cfsetispeed' error, baudrate: [" + sl::support::to_string(conf.baud_rate) + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+    }
+}
+
+void set_byte_size(const serial_config& conf, struct termios& tty) {
+    switch(conf.byte_size) {
+    case 5: tty.c_cflag |= CS5; break;
+    case 6: tty.c_cflag |= CS6; break;
+    case 7: tty.c_cflag |= CS7; break;
+    case 8: tty.c_cflag |= CS8; break;
+    default: throw support::exception(TRACEMSG(
+            "Invalid 'byteSize' specified: [" + sl::support::to_string(conf.byte_size) + "]"));
+    }
+}
+
+void set_stop_bits(const serial_config& conf, struct termios& tty) {
+    switch(conf.stop_bits_count) {
+    case 1: tty.c_cflag &= ~(CSTOPB); break;
+    case 2: tty.c_cflag |= (CSTOPB); break;
+    default: throw support::exception(TRACEMSG(
+            "Invalid 'stopBitsCount' specified: [" + sl::support::to_string(conf.byte_size) + "]"));
+    }
+}
+
+void set_parity(const serial_config& conf, struct termios& tty) {
+    tty.c_iflag &= ~(INPCK | ISTRIP);
+    switch(conf.parity) {
+    case parity_type::none: {
+        tty.c_cflag &= ~(PARENB | PARODD | CMSPAR);
+        break;
+    }
+    case parity_type::even: {
+        tty.c_cflag &= ~(PARODD | CMSPAR);
+        tty.c_cflag |= (PARENB);
+        break;
+    }
+    case parity_type::odd: {
+        tty.c_cflag &= ~CMSPAR;
+        tty.c_cflag |= (PARENB | PARODD);
+        break;
+    }
+    case parity_type::mark: {
+        tty.c_cflag |= (PARENB | CMSPAR | PARODD);
+        break;
+    }
+    case parity_type::space: {
+        tty.c_cflag |= (PARENB | CMSPAR);
+        tty.c_cflag &= ~(PARODD);
+        break;
+    }
+    default: throw support::exception(TRACEMSG(
+            "Invalid 'parity' specified: [" + stringify_parity_type(conf.parity) + "]"));
+    }
+}
+
+void set_flow_control(struct termios& tty) {
+    // setup flow control
+    tty.c_iflag &= ~(IXON | IXOFF | IXANY);
+    tty.c_cflag &= ~(CRTSCTS);
+
+    // buffer
+    tty.c_cc[VMIN] = 0;
+    tty.c_cc[VTIME] = 0;
+}
+
+void derive_tty_params(const serial_config& conf, struct termios& tty) {
+    set_tty_mode(tty);
+    set_baud_rate(conf, tty);
+    set_byte_size(conf, tty);
+    set_stop_bits(conf, tty);
+    set_parity(conf, tty);
+    set_flow_control(tty);
+}
+
+void apply_line_settings(const line_settings& ls, struct termios& tty) {
+    tty.c_iflag = (tty.c_iflag & ls.iflag_keep) | ls.iflag_set;
+    tty.c_oflag = (tty.c_oflag & ls.oflag_keep) | ls.oflag_set;
+    tty.c_cflag = (tty.c_cflag & ls.cflag_keep) | ls.cflag_set;
+    tty.c_lflag = (tty.c_lflag & ls.lflag_keep) | ls.lflag_set;
+    tty.c_cc[VMIN] = ls.vmin;
+    tty.c_cc[VTIME] = ls.vtime;
+    // validated on compile, only sets the speed fields
+    ::cfsetospeed(std::addressof(tty), static_cast<speed_t>(ls.speed));
+    ::cfsetispeed(std::addressof(tty), static_cast<speed_t>(ls.speed));
+}
+
+} // namespace
+
 class connection::impl : public staticlib::pimpl::object::impl {
     serial_config conf;
 
     int fd = -1;
 
+    // set only when this descriptor put the tty into exclusive mode
+    bool excl_set = false;
+
+    // data returned back by the caller, consumed before reading from the port
+    std::string unread_data;
+
+    // path used to reopen the device, stable across re-enumeration when possible
+    std::string reopen_path;
+    uint32_t reconnects_count = 0;
+    // backoff state, kept across the reads, zero while the port is open
+    uint32_t reconnect_delay = 0;
+    uint64_t reconnect_next_attempt = 0;
+
+    // coalescing transmit queue, only created if enabled in config
+    std::unique_ptr<tx_queue> tx;
+
+    // started by the first modem lines wait, stopped before the port is closed
+    std::shared_ptr<modem_waiter> waiter;
+
+    // RTS is switched by the driver, otherwise it is switched around 'write_drain'
+    bool rs485_kernel = false;
+
 public:
     impl(serial_config&& conf) :
     conf(std::move(conf)) {
-        // open port
-        this->fd = ::open(this->conf.port.c_str(), O_RDWR | O_NOCTTY | O_SYNC);
-        if (this->fd < 0) {
-            throw support::exception(TRACEMSG(
-                "Serial 'open' error, port: [" + this->conf.port + "],"
-                " error: [" + ::strerror(errno) + "]"));
+        if (nullptr == this->conf.precompiled.get()) {
+            this->conf.precompiled = std::make_shared<const line_settings>(compile_line_settings(this->conf));
+        }
+        open_port(this->conf.port, this->conf.exclusive_wait_millis);
+        this->reopen_path = this->conf.reconnect ? find_stable_path(this->conf.port) : this->conf.port;
+        if (this->conf.coalesce_micros > 0) {
+            this->tx.reset(new tx_queue([this](sl::io::span<const char> data) {
+                return this->write_direct(data);
+            }, this->conf.coalesce_micros, this->conf.coalesce_max_bytes));
         }
-
-        // set params
-        struct termios tty;
-        std::memset(std::addressof(tty), '\0', sizeof(tty));
-        load_tty_params(tty);
-        set_tty_mode(tty);
-        set_baud_rate(tty);
-        set_byte_size(tty);
-        set_stop_bits(tty);
-        set_parity(tty);
-        set_flow_control(tty);
-        apply_tty_params(tty);
-        flush_input_buffer();
     }
 
     ~impl() STATICLIB_NOEXCEPT {
-        close_descriptor(fd);
+        // queued data must be written before the port is closed
+        tx.reset();
+        close_port();
     };
     
     std::string read(connection&, uint32_t length) {
         uint64_t start = sl::utils::current_time_millis_steady();
-        return read_some(start, length, conf.timeout_millis);
+        std::string res;
+        res.resize(length);
+        size_t read = read_some(start, {std::addressof(res.front()), res.length()}, conf.timeout_millis);
+        res.resize(read);
+        return res;
+    }
+
+    uint32_t read_into(connection&, sl::io::span<char> buf) {
+        uint64_t start = sl::utils::current_time_millis_steady();
+        size_t read = read_some(start, buf, conf.timeout_millis);
+        return static_cast<uint32_t>(read);
+    }
+
+    uint32_t read_available(connection&, sl::io::span<char> buf, uint32_t timeout_millis) {
+        uint64_t start = sl::utils::current_time_millis_steady();
+        size_t read = read_some(start, buf, timeout_millis, true);
+        return static_cast<uint32_t>(read);
     }
 
     std::string read_line(connection&) {
@@ -82,13 +276,25 @@ public:
         uint64_t finish = start + conf.timeout_millis;
         uint64_t cur = start;
         std::string res;
+        std::array<char, 256> buf;
         for(;;) {
             uint32_t passed = static_cast<uint32_t> (cur - start);
-            auto ch = this->read_some(cur, 1, conf.timeout_millis - passed);
-            if (ch.empty() || '\n' == ch.at(0)) {
+            auto read = this->read_some(cur, {buf.data(), buf.size()}, conf.timeout_millis - passed, true);
+            if (0 == read) {
                 break;
             }
-            res.push_back(ch.at(0));
+            auto nl = static_cast<const char*>(std::memchr(buf.data(), '\n', read));
+            if (nullptr != nl) {
+                size_t line_len = static_cast<size_t>(nl - buf.data());
+                res.append(buf.data(), line_len);
+                // keep the data after the line end for the next read
+                size_t rest = read - line_len - 1;
+                if (rest > 0) {
+                    unread_data.insert(0, nl + 1, rest);
+                }
+                break;
+            }
+            res.append(buf.data(), read);
             cur = sl::utils::current_time_millis_steady();
             if (cur >= finish) {
                 break;
@@ -101,22 +307,219 @@ public:
     }
 
     uint32_t write(connection&, sl::io::span<const char> data) {
+        if (nullptr != tx.get()) {
+            return tx->write(data);
+        }
+        return write_direct(data);
+    }
+
+    void flush(connection&) {
+        if (nullptr != tx.get()) {
+            tx->flush();
+        }
+    }
+
+    void drain(connection& frontend) {
+        flush(frontend);
+        if (-1 == this->fd) {
+            return;
+        }
+        auto err = ::tcdrain(fd);
+        if (0 != err) {
+            throw support::exception(TRACEMSG(
+                "Serial 'tcdrain' error: [" + ::strerror(errno) + "]"));
+        }
+    }
+
+    uint32_t write_drain(connection& frontend, sl::io::span<const char> data) {
+        flush(frontend);
+        bool rts_manual = conf.rs485 && !rs485_kernel;
+        if (rts_manual) {
+            set_rts(conf.rs485_rts_on_send);
+            sleep_until_precise(std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(conf.rs485_delay_before_send_millis));
+        }
+        auto start = std::chrono::steady_clock::now();
+        uint32_t written = write_direct(data);
+        drain(frontend);
+        // tcdrain may return while the last bytes are still in the UART FIFO
+        sleep_until_precise(start + transmit_time(conf, written));
+        if (rts_manual) {
+            sleep_until_precise(std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(conf.rs485_delay_after_send_millis));
+            set_rts(conf.rs485_rts_after_send);
+        }
+        return written;
+    }
+
+    void unread(connection&, sl::io::span<const char> data) {
+        unread_data.insert(0, data.data(), data.size());
+    }
+
+    sl::json::value modem_lines(connection&) {
+        check_open();
+        int status = 0;
+        auto err = ::ioctl(fd, TIOCMGET, std::addressof(status));
+        if (0 != err) {
+            throw support::exception(TRACEMSG(
+                    "Serial 'TIOCMGET' error: [" + ::strerror(errno) + "]"));
+        }
+        return {
+            { "DTR", 0 != (status & TIOCM_DTR) },
+            { "RTS", 0 != (status & TIOCM_RTS) },
+            { "CTS", 0 != (status & TIOCM_CTS) },
+            { "DSR", 0 != (status & TIOCM_DSR) },
+            { "DCD", 0 != (status & TIOCM_CD) },
+            { "RI", 0 != (status & TIOCM_RNG) }
+        };
+    }
+
+    void set_modem_line(connection&, modem_line line, bool value) {
+        check_open();
+        int flag = 0;
+        switch (line) {
+        case modem_line::dtr: flag = TIOCM_DTR; break;
+        case modem_line::rts: flag = TIOCM_RTS; break;
+        default: throw support::exception(TRACEMSG(
+                "Input modem line cannot be set: [" + stringify_modem_line(line) + "]"));
+        }
+        auto err = ::ioctl(fd, value ? TIOCMBIS : TIOCMBIC, std::addressof(flag));
+        if (0 != err) {
+            throw support::exception(TRACEMSG(
+                    "Serial 'TIOCMSET' error, line: [" + stringify_modem_line(line) + "]," +
+                    " error: [" + ::strerror(errno) + "]"));
+        }
+    }
+
+    void send_break(connection& frontend, uint32_t duration_millis) {
+        check_open();
+        // break starts after the pending output is sent
+        drain(frontend);
+        if (0 == duration_millis) {
+            auto err = ::tcsendbreak(fd, 0);
+            if (0 != err) {
+                throw support::exception(TRACEMSG(
+                        "Serial 'tcsendbreak' error: [" + ::strerror(errno) + "]"));
+            }
+            return;
+        }
+        auto err = ::ioctl(fd, TIOCSBRK);
+        if (0 != err) {
+            throw support::exception(TRACEMSG(
+                    "Serial 'TIOCSBRK' error: [" + ::strerror(errno) + "]"));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(duration_millis));
+        err = ::ioctl(fd, TIOCCBRK);
+        if (0 != err) {
+            throw support::exception(TRACEMSG(
+                    "Serial 'TIOCCBRK' error: [" + ::strerror(errno) + "]"));
+        }
+    }
+
+    bool wait_modem_change(connection&, const std::vector<modem_line>& lines, uint32_t timeout_millis,
+            std::mutex& io_mutex) {
+        modem_monitor::check_lines(lines);
+        uint32_t timeout = timeout_millis > 0 ? timeout_millis : conf.timeout_millis;
+        uint64_t finish = sl::utils::current_time_millis_steady() + timeout;
+        // lines are compared against the state taken on the same open port
+        auto monitor = std::unique_ptr<modem_monitor>();
+        uint32_t monitor_reconnects = 0;
+        for (;;) {
+            // copy is kept outside of the lock, the port may be closed while waiting on it
+            auto wt = std::shared_ptr<modem_waiter>();
+            uint64_t seen = 0;
+            {
+                // port may be closed and reopened by the background reader between the polls
+                std::lock_guard<std::mutex> guard{io_mutex};
+                if (-1 == fd && !conf.reconnect) {
+                    check_open();
+                }
+                if (-1 != fd) {
+                    wt = start_waiter();
+                    seen = nullptr != wt.get() ? wt->events_count() : 0;
+                }
+                if (-1 == fd) {
+                    // port is lost, lines state is taken again after it is reopened
+                    monitor.reset();
+                } else if (nullptr == monitor.get() || monitor_reconnects != reconnects_count) {
+                    monitor.reset(new modem_monitor(fd, lines));
+                    monitor_reconnects = reconnects_count;
+                } else if (monitor->poll(fd)) {
+                    return true;
+                }
+            }
+            uint64_t cur = sl::utils::current_time_millis_steady();
+            if (cur >= finish) {
+                return false;
+            }
+            if (nullptr != wt.get() && wt->wait_event(seen, finish)) {
+                continue;
+            }
+            uint64_t sleep = std::min(static_cast<uint64_t>(conf.modem_poll_millis), finish - cur);
+            std::this_thread::sleep_for(std::chrono::milliseconds(sleep));
+        }
+    }
+
+    const serial_config& config(const connection&) const {
+        return conf;
+    }
+
+    int poll_fd(const connection&) const {
+        return fd;
+    }
+
+    bool has_unread(const connection&) const {
+        return !unread_data.empty();
+    }
+
+    sl::json::value status(const connection&) const {
+        return {
+            { "port", conf.port },
+            { "reopenPath", reopen_path },
+            { "connected", -1 != fd },
+            { "reconnectsCount", reconnects_count },
+            { "rs485Mode", conf.rs485 ? (rs485_kernel ? "KERNEL" : "SOFTWARE") : "DISABLED" }
+        };
+    }
+
+private:
+    uint32_t write_direct(sl::io::span<const char> data) {
         uint64_t start = sl::utils::current_time_millis_steady();
         uint64_t finish = start + conf.timeout_millis;
         uint64_t cur = start;
         size_t written = 0;
         for(;;) {
+            if (-1 == this->fd) {
+                if (!reconnect(finish)) {
+                    break;
+                }
+                cur = sl::utils::current_time_millis_steady();
+                if (cur >= finish) {
+                    break;
+                }
+            }
             struct pollfd pfd;
             std::memset(std::addressof(pfd), '\0', sizeof(pfd));
             pfd.fd = this->fd;
             pfd.events = POLLOUT;
             uint32_t passed = static_cast<uint32_t> (cur - start);
             int ptm = static_cast<int> (conf.timeout_millis - passed);
+            WILTON_SERIAL_PROBE2(poll_enter, this->fd, ptm);
+            uint64_t poll_start = WILTON_SERIAL_PROBE_NANOS();
             auto err = ::poll(std::addressof(pfd), 1, ptm);
-            check_poll_err(pfd, err, "", ptm);
+            WILTON_SERIAL_PROBE3(poll_exit, this->fd, err, WILTON_SERIAL_PROBE_NANOS() - poll_start);
+            if (device_lost(pfd, err)) {
+                close_port();
+                continue;
+            }
+            check_poll_err(pfd, err, {data.data(), 0}, ptm);
             if (pfd.revents & POLLOUT) {
                 auto wr = ::write(this->fd, data.data() + written, data.size() - written);
-                if (-1 == wr) {
+                WILTON_SERIAL_PROBE2(write, this->fd, wr);
+                if (-1 == wr && device_lost_errno(errno)) {
+                    close_port();
+                    continue;
+                } else if (-1 == wr) {
                     throw support::exception(TRACEMSG(
                             "Serial 'write' error, written: [" + sl::support::to_string(written) + "],"
                             " error: [" + ::strerror(errno) + "]"));
@@ -134,76 +537,275 @@ public:
         return static_cast<uint32_t>(written);
     }
 
-private:
     static void close_descriptor(int fd) STATICLIB_NOEXCEPT {
         if (-1 != fd) {
             ::close(fd);
         }
     }
 
-    static void check_poll_err(struct pollfd& pfd, int err, const std::string& res, int timeout) {
+    void open_port(const std::string& path, uint32_t lock_wait_millis) {
+        uint64_t finish = sl::utils::current_time_millis_steady() + lock_wait_millis;
+        // open port, EBUSY is returned while other process holds TIOCEXCL
+        for (;;) {
+            this->fd = ::open(path.c_str(), O_RDWR | O_NOCTTY | O_SYNC);
+            if (this->fd >= 0 || !conf.exclusive || EBUSY != errno ||
+                    sl::utils::current_time_millis_steady() >= finish) {
+                break;
+            }
+            std::this_thread::sleep_for(lock_retry_interval);
+        }
+        if (this->fd < 0) {
+            throw support::exception(TRACEMSG(
+                "Serial 'open' error, port: [" + path + "],"
+                " error: [" + ::strerror(errno) + "]"));
+        }
+        WILTON_SERIAL_PROBE2(open, this->fd, path.c_str());
+
+        // set params
+        try {
+            if (conf.exclusive) {
+                lock_port(path, finish);
+            }
+            struct termios tty;
+            std::memset(std::addressof(tty), '\0', sizeof(tty));
+            load_tty_params(tty);
+            apply_line_settings(*conf.precompiled, tty);
+            apply_tty_params(tty);
+            flush_buffers();
+            if (conf.rs485) {
+                this->rs485_kernel = setup_rs485();
+                if (!rs485_kernel) {
+                    set_rts(conf.rs485_rts_after_send);
+                }
+            }
+        } catch (...) {
+            close_port();
+            throw;
+        }
+    }
+
+    // flock is honoured by the cooperating processes (and by lockdev-aware tools),
+    // TIOCEXCL makes the kernel reject all other opens of this tty
+    void lock_port(const std::string& path, uint64_t finish) {
+        while (0 != ::flock(fd, LOCK_EX | LOCK_NB)) {
+            if (EWOULDBLOCK != errno) throw support::exception(TRACEMSG(
+                    "Serial 'flock' error, port: [" + path + "],"
+                    " error: [" + ::strerror(errno) + "]"));
+            if (sl::utils::current_time_millis_steady() >= finish) throw support::exception(TRACEMSG(
+                    "Serial port is locked by another process, port: [" + path + "],"
+                    " wait: [" + sl::support::to_string(conf.exclusive_wait_millis) + "]"));
+            std::this_thread::sleep_for(lock_retry_interval);
+        }
+        if (0 != ::ioctl(fd, TIOCEXCL)) throw support::exception(TRACEMSG(
+                "Serial 'TIOCEXCL' error, port: [" + path + "],"
+                " error: [" + ::strerror(errno) + "]"));
+        this->excl_set = true;
+    }
+
+    void check_open() {
+        if (-1 == this->fd) {
+            throw support::exception(TRACEMSG(
+                "Serial port is not open, port: [" + conf.port + "]"));
+        }
+    }
+
+    // called under the I/O lock
+    std::shared_ptr<modem_waiter> start_waiter() {
+        if (nullptr == waiter.get()) {
+            this->waiter = std::make_shared<modem_waiter>(fd);
+        }
+        return waiter;
+    }
+
+    void close_port() STATICLIB_NOEXCEPT {
+        // helper blocked in TIOCMIWAIT is not woken by 'close'
+        if (nullptr != waiter.get()) {
+            waiter->stop();
+            waiter.reset();
+        }
+        if (-1 != fd) {
+            WILTON_SERIAL_PROBE1(close, fd);
+            // exclusive flag stays on the tty while it has other openers
+            if (excl_set) {
+                ::ioctl(fd, TIOCNXCL);
+            }
+        }
+        close_descriptor(fd);
+        this->fd = -1;
+        this->excl_set = false;
+    }
+
+    // USB adapters get a new tty name on re-enumeration, by-id link follows the device
+    static std::string find_stable_path(const std::string& port) {
+        static const std::string by_id_dir = "/dev/serial/by-id";
+        char real_port[PATH_MAX];
+        if (nullptr == ::realpath(port.c_str(), real_port)) {
+            return port;
+        }
+        auto dir = ::opendir(by_id_dir.c_str());
+        if (nullptr == dir) {
+            return port;
+        }
+        auto deferred = sl::support::defer([dir]() STATICLIB_NOEXCEPT {
+            ::closedir(dir);
+        });
+        for (auto en = ::readdir(dir); nullptr != en; en = ::readdir(dir)) {
+            auto link = by_id_dir + "/" + en->d_name;
+            char real_link[PATH_MAX];
+            if ('.' != en->d_name[0] &&
+                    nullptr != ::realpath(link.c_str(), real_link) &&
+                    0 == std::strcmp(real_port, real_link)) {
+                return link;
+            }
+        }
+        return port;
+    }
+
+    bool device_lost(struct pollfd& pfd, int err) {
+        return conf.reconnect && err > 0 && (pfd.revents & (POLLERR | POLLHUP | POLLNVAL));
+    }
+
+    bool device_lost_errno(int code) {
+        return conf.reconnect && (EIO == code || ENXIO == code || ENODEV == code);
+    }
+
+    // returns false if the device did not come back before the deadline,
+    // attempts are spaced by the backoff delay across the calls, so the readers
+    // that work in short slices do not retry the open on every slice
+    bool reconnect(uint64_t finish) {
+        if (0 == reconnect_delay) {
+            // give the device time to re-enumerate before the first attempt
+            this->reconnect_delay = conf.reconnect_backoff_min_millis;
+            this->reconnect_next_attempt = sl::utils::current_time_millis_steady() + reconnect_delay;
+        }
+        for (;;) {
+            uint64_t cur = sl::utils::current_time_millis_steady();
+            if (cur < reconnect_next_attempt) {
+                if (cur >= finish) {
+                    return false;
+                }
+                uint64_t sleep = std::min(reconnect_next_attempt, finish) - cur;
+                std::this_thread::sleep_for(std::chrono::milliseconds(sleep));
+                continue;
+            }
+            try {
+                // reconnect loop does its own waiting
+                open_port(reopen_path, 0);
+                reconnects_count += 1;
+                this->reconnect_delay = 0;
+                this->reconnect_next_attempt = 0;
+                return true;
+            } catch (const std::exception&) {
+                // device is not back yet
+            }
+            uint64_t next_delay = static_cast<uint64_t>(reconnect_delay) * 2;
+            this->reconnect_delay = static_cast<uint32_t>(std::min(next_delay,
+                    static_cast<uint64_t>(conf.reconnect_backoff_max_millis)));
+            this->reconnect_next_attempt = sl::utils::current_time_millis_steady() + reconnect_delay;
+        }
+    }
+
+    static void check_poll_err(struct pollfd& pfd, int err, sl::io::span<const char> res, int timeout) {
         if (err < 0) {
             if (EINTR == errno) {
                 return; // Interrupted system call
             }
             throw support::exception(TRACEMSG(
                     "Serial 'poll' error, timeout: [" + sl::support::to_string(timeout) + "],"
-                    " current res: [" + res + "]" +
+                    " current res: [" + std::string(res.data(), res.size()) + "]" +
                     " error: [" + ::strerror(errno) + "]"));
         }
         if (pfd.revents & POLLERR) {
             throw support::exception(TRACEMSG(
                     "Serial 'poll' error, timeout: [" + sl::support::to_string(timeout) + "],"
-                    " current res: [" + res + "]" +
+                    " current res: [" + std::string(res.data(), res.size()) + "]" +
                     " error: [POLLERR]"));
         } else if (pfd.revents & POLLHUP) {
             throw support::exception(TRACEMSG(
                     "Serial 'poll' error, timeout: [" + sl::support::to_string(timeout) + "],"
-                    " current res: [" + res + "]" +
+                    " current res: [" + std::string(res.data(), res.size()) + "]" +
                     " error: [POLLHUP]"));
         } else if (pfd.revents & POLLNVAL) {
             throw support::exception(TRACEMSG(
                     "Serial 'poll' error, timeout: [" + sl::support::to_string(timeout) + "],"
-                    " current res: [" + res + "]" +
+                    " current res: [" + std::string(res.data(), res.size()) + "]" +
                     " error: [POLLNVAL]"));
         }
     }
 
-    std::string read_some(uint64_t start, uint32_t length, uint32_t timeout_millis) {
+    size_t take_unread(sl::io::span<char> buf) {
+        if (unread_data.empty()) {
+            return 0;
+        }
+        size_t len = std::min(buf.size(), unread_data.length());
+        std::memcpy(buf.data(), unread_data.data(), len);
+        unread_data.erase(0, len);
+        return len;
+    }
+
+    size_t read_some(uint64_t start, sl::io::span<char> buf, uint32_t timeout_millis,
+            bool return_partial = false) {
         uint64_t finish = start + timeout_millis;
         uint64_t cur = start;
-        std::string res;
+        uint64_t probe_start = WILTON_SERIAL_PROBE_NANOS();
+        // reply is expected to the queued request, no need to wait for the window
+        if (nullptr != tx.get()) {
+            tx->flush();
+        }
+        size_t filled = take_unread(buf);
+        if (filled >= buf.size() || (return_partial && filled > 0)) {
+            return filled;
+        }
         for (;;) {
+            if (-1 == this->fd) {
+                if (!reconnect(finish)) {
+                    break;
+                }
+                cur = sl::utils::current_time_millis_steady();
+                if (cur >= finish) {
+                    break;
+                }
+            }
             struct pollfd pfd;
             std::memset(std::addressof(pfd), '\0', sizeof(pfd));
             pfd.fd = this->fd;
             pfd.events = POLLIN;
             uint32_t passed = static_cast<uint32_t> (cur - start);
             int ptm = static_cast<int> (timeout_millis - passed);
+            WILTON_SERIAL_PROBE2(poll_enter, this->fd, ptm);
+            uint64_t poll_start = WILTON_SERIAL_PROBE_NANOS();
             auto err = ::poll(std::addressof(pfd), 1, ptm);
-            check_poll_err(pfd, err, res, ptm);
+            WILTON_SERIAL_PROBE3(poll_exit, this->fd, err, WILTON_SERIAL_PROBE_NANOS() - poll_start);
+            if (device_lost(pfd, err)) {
+                close_port();
+                continue;
+            }
+            check_poll_err(pfd, err, {buf.data(), filled}, ptm);
             if (err > 0 && (pfd.revents & POLLIN)) {
-                auto prev_len = res.length();
-                res.resize(length);
-                auto rlen = length - prev_len;
-                auto read = ::read(this->fd, std::addressof(res.front()) + prev_len, rlen);
-                if (-1 == read) {
+                auto rlen = buf.size() - filled;
+                auto read = ::read(this->fd, buf.data() + filled, rlen);
+                WILTON_SERIAL_PROBE2(read, this->fd, read);
+                if (-1 == read && device_lost_errno(errno)) {
+                    close_port();
+                    continue;
+                } else if (-1 == read) {
                     throw support::exception(TRACEMSG(""
                         "Serial 'read' error, len: [" + sl::support::to_string(rlen) + "],"
                         " error: [" + ::strerror(errno) + "]"));
                 }
-                res.resize(prev_len + read);
-                if (res.length() >= length) {
+                filled += static_cast<size_t>(read);
+                if (filled >= buf.size() || (return_partial && filled > 0)) {
                     break;
                 }
             }
             
             cur = sl::utils::current_time_millis_steady();
             if (cur >= finish) {
+                WILTON_SERIAL_PROBE3(timeout, this->fd, filled, WILTON_SERIAL_PROBE_NANOS() - probe_start);
                 break;
             }
         }
-        return res;
+        return filled;
     }
 
     void load_tty_params(struct termios& tty) {
@@ -214,136 +816,51 @@ private:
         }
     }
 
-    void set_tty_mode(struct termios& tty) {
-        tty.c_cflag |= (CLOCAL | CREAD);
-
-        tty.c_lflag &= ~(ICANON | ECHO | ECHOE |
-                ECHOK | ECHONL |
-                ISIG | IEXTEN); // | ECHOPRT
-        tty.c_lflag &= ~ECHOCTL;
-        tty.c_lflag &= ~ECHOKE;
-
-        tty.c_oflag &= ~(OPOST | ONLCR | OCRNL);
-
-        tty.c_iflag &= ~(INLCR | IGNCR | ICRNL | IGNBRK);
-        tty.c_iflag &= ~IUCLC;
-        tty.c_iflag &= ~PARMRK;
-    }
-
-    void set_baud_rate(struct termios& tty) {
-        speed_t rate = B0;
-        switch (conf.baud_rate) {
-        case 0: rate = B0; break;
-        case 50: rate = B50; break;
-        case 75: rate = B75; break;
-        case 110: rate = B110; break;
-        case 134: rate = B134; break;
-        case 150: rate = B150; break;
-        case 200: rate = B200; break;
-        case 300: rate = B300; break;
-        case 600: rate = B600; break;
-        case 1200: rate = B1200; break;
-        case 1800: rate = B1800; break;
-        case 2400: rate = B2400; break;
-        case 4800: rate = B4800; break;
-        case 9600: rate = B9600; break;
-        case 19200: rate = B19200; break;
-        case 38400: rate = B38400; break;
-        case 57600: rate = B57600; break;
-        case 115200: rate = B115200; break;
-        case 230400: rate = B230400; break;
-        case 460800: rate = B460800; break;
-        case 500000: rate = B500000; break;
-        case 576000: rate = B576000; break;
-        case 921600: rate = B921600; break;
-        default: throw support::exception(TRACEMSG(
-                "Invalid 'baudRate' specified: [" + sl::support::to_string(conf.baud_rate) + "]"));
-        }
-        auto err_o = ::cfsetospeed(std::addressof(tty), rate);
-        if (0 != err_o) {
-            throw support::exception(TRACEMSG(
-                "Serial 'cfsetospeed' error, baudrate: [" + sl::support::to_string(conf.baud_rate) + "]," +
-                " error: [" + ::strerror(errno) + "]"));
-        }
-        auto err_i = ::cfsetispeed(std::addressof(tty), rate);
-        if (0 != err_i) {
+    void apply_tty_params(struct termios& tty) {
+        auto err = ::tcsetattr(fd, TCSANOW, std::addressof(tty));
+        if (0 != err) {
             throw support::exception(TRACEMSG(
-                "Serial 'cfsetispeed' error, baudrate: [" + sl::support::to_string(conf.baud_rate) + "]," +
-                " error: [" + ::strerror(errno) + "]"));
-        }
-    }
-
-    void set_byte_size(struct termios& tty) {
-        switch(conf.byte_size) {
-        case 5: tty.c_cflag |= CS5; break;
-        case 6: tty.c_cflag |= CS6; break;
-        case 7: tty.c_cflag |= CS7; break;
-        case 8: tty.c_cflag |= CS8; break;
-        default: throw support::exception(TRACEMSG(
-                "Invalid 'byteSize' specified: [" + sl::support::to_string(conf.byte_size) + "]"));
-        }
-    }
-
-    void set_stop_bits(struct termios& tty) {
-        switch(conf.stop_bits_count) {
-        case 1: tty.c_cflag &= ~(CSTOPB); break;
-        case 2: tty.c_cflag |= (CSTOPB); break;
-        default: throw support::exception(TRACEMSG(
-                "Invalid 'stopBitsCount' specified: [" + sl::support::to_string(conf.byte_size) + "]"));
+                "Serial 'tcsetattr' error: [" + ::strerror(errno) + "]"));
         }
     }
-
-    void set_parity(struct termios& tty) {
-        tty.c_iflag &= ~(INPCK | ISTRIP);
-        switch(conf.parity) {
-        case parity_type::none: {
-            tty.c_cflag &= ~(PARENB | PARODD | CMSPAR);
-            break;
-        }
-        case parity_type::even: {
-            tty.c_cflag &= ~(PARODD | CMSPAR);
-            tty.c_cflag |= (PARENB);
-            break;
-        }
-        case parity_type::odd: {
-            tty.c_cflag &= ~CMSPAR;
-            tty.c_cflag |= (PARENB | PARODD);
-            break;
-        }
-        case parity_type::mark: {
-            tty.c_cflag |= (PARENB | CMSPAR | PARODD);
-            break;
-        }
-        case parity_type::space: {
-            tty.c_cflag |= (PARENB | CMSPAR);
-            tty.c_cflag &= ~(PARODD);
-            break;
+    
+    // returns false if kernel RS-485 mode is not supported by the driver (pty, most USB adapters)
+    bool setup_rs485() {
+#ifdef TIOCSRS485
+        struct serial_rs485 rs;
+        std::memset(std::addressof(rs), '\0', sizeof(rs));
+        rs.flags = SER_RS485_ENABLED;
+        if (conf.rs485_rts_on_send) {
+            rs.flags |= SER_RS485_RTS_ON_SEND;
         }
-        default: throw support::exception(TRACEMSG(
-                "Invalid 'parity' specified: [" + stringify_parity_type(conf.parity) + "]"));
+        if (conf.rs485_rts_after_send) {
+            rs.flags |= SER_RS485_RTS_AFTER_SEND;
         }
+        rs.delay_rts_before_send = conf.rs485_delay_before_send_millis;
+        rs.delay_rts_after_send = conf.rs485_delay_after_send_millis;
+        return 0 == ::ioctl(fd, TIOCSRS485, std::addressof(rs));
+#else // !TIOCSRS485
+        return false;
+#endif // TIOCSRS485
     }
 
-    void set_flow_control(struct termios& tty) {
-        // setup flow control
-        tty.c_iflag &= ~(IXON | IXOFF | IXANY);
-        tty.c_cflag &= ~(CRTSCTS);
-
-        // buffer
-        tty.c_cc[VMIN] = 0;
-        tty.c_cc[VTIME] = 0;
+    // errors are ignored, line may be not available (pty)
+    void set_rts(bool level) STATICLIB_NOEXCEPT {
+        int flag = TIOCM_RTS;
+        ::ioctl(fd, level ? TIOCMBIS : TIOCMBIC, std::addressof(flag));
     }
 
-    void apply_tty_params(struct termios& tty) {
-        auto err = ::tcsetattr(fd, TCSANOW, std::addressof(tty));
-        if (0 != err) {
-            throw support::exception(TRACEMSG(
-                "Serial 'tcsetattr' error: [" + ::strerror(errno) + "]"));
+    void flush_buffers() {
+        int selector = 0;
+        switch (conf.flush_on_open) {
+        case flush_type::none: return;
+        case flush_type::input: selector = TCIFLUSH; break;
+        case flush_type::output: selector = TCOFLUSH; break;
+        case flush_type::both: selector = TCIOFLUSH; break;
+        default: throw support::exception(TRACEMSG("Invalid flush type: [" +
+                stringify_flush_type(conf.flush_on_open) + "]"));
         }
-    }
-    
-    void flush_input_buffer() {
-        auto err = ::tcflush(fd, TCIFLUSH);
+        auto err = ::tcflush(fd, selector);
         if (0 != err) {
             throw support::exception(TRACEMSG(
                 "Serial 'tcflush' error: [" + ::strerror(errno) + "]"));
@@ -351,10 +868,50 @@ private:
     }
 
 };
+
+// every flag bit is either set, cleared or left as is, so running the same
+// derivation over all-zero and all-one structs gives the masks to apply
+line_settings compile_line_settings(const serial_config& conf) {
+    static_assert(sizeof(tcflag_t) <= sizeof(uint32_t), "Unsupported termios flag size");
+    struct termios zeros;
+    std::memset(std::addressof(zeros), '\0', sizeof(zeros));
+    derive_tty_params(conf, zeros);
+    struct termios ones;
+    std::memset(std::addressof(ones), '\xff', sizeof(ones));
+    derive_tty_params(conf, ones);
+    line_settings res;
+    res.iflag_keep = static_cast<uint32_t>(ones.c_iflag);
+    res.iflag_set = static_cast<uint32_t>(zeros.c_iflag);
+    res.oflag_keep = static_cast<uint32_t>(ones.c_oflag);
+    res.oflag_set = static_cast<uint32_t>(zeros.c_oflag);
+    res.cflag_keep = static_cast<uint32_t>(ones.c_cflag);
+    res.cflag_set = static_cast<uint32_t>(zeros.c_cflag);
+    res.lflag_keep = static_cast<uint32_t>(ones.c_lflag);
+    res.lflag_set = static_cast<uint32_t>(zeros.c_lflag);
+    res.vmin = static_cast<uint8_t>(zeros.c_cc[VMIN]);
+    res.vtime = static_cast<uint8_t>(zeros.c_cc[VTIME]);
+    res.speed = static_cast<uint32_t>(::cfgetospeed(std::addressof(zeros)));
+    return res;
+}
+
 PIMPL_FORWARD_CONSTRUCTOR(connection, (serial_config&&), (), support::exception)
 PIMPL_FORWARD_METHOD(connection, std::string, read, (uint32_t), (), support::exception)
+PIMPL_FORWARD_METHOD(connection, uint32_t, read_into, (sl::io::span<char>), (), support::exception)
+PIMPL_FORWARD_METHOD(connection, uint32_t, read_available, (sl::io::span<char>)(uint32_t), (), support::exception)
 PIMPL_FORWARD_METHOD(connection, std::string, read_line, (), (), support::exception)
 PIMPL_FORWARD_METHOD(connection, uint32_t, write, (sl::io::span<const char>), (), support::exception)
+PIMPL_FORWARD_METHOD(connection, void, flush, (), (), support::exception)
+PIMPL_FORWARD_METHOD(connection, void, drain, (), (), support::exception)
+PIMPL_FORWARD_METHOD(connection, uint32_t, write_drain, (sl::io::span<const char>), (), support::exception)
+PIMPL_FORWARD_METHOD(connection, void, unread, (sl::io::span<const char>), (), support::exception)
+PIMPL_FORWARD_METHOD(connection, sl::json::value, modem_lines, (), (), support::exception)
+PIMPL_FORWARD_METHOD(connection, void, set_modem_line, (modem_line)(bool), (), support::exception)
+PIMPL_FORWARD_METHOD(connection, void, send_break, (uint32_t), (), support::exception)
+PIMPL_FORWARD_METHOD(connection, bool, wait_modem_change, (const std::vector<modem_line>&)(uint32_t)(std::mutex&), (), support::exception)
+PIMPL_FORWARD_METHOD(connection, const serial_config&, config, (), (const), support::exception)
+PIMPL_FORWARD_METHOD(connection, int, poll_fd, (), (const), support::exception)
+PIMPL_FORWARD_METHOD(connection, bool, has_unread, (), (const), support::exception)
+PIMPL_FORWARD_METHOD(connection, sl::json::value, status, (), (const), support::exception)
 
 } // namespace
 }
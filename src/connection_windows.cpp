@@ -23,7 +23,11 @@
 
 #include "connection.hpp"
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <memory>
+#include <thread>
 #include <tuple>
 
 #include "staticlib/support/windows.hpp"
@@ -32,41 +36,152 @@
 #include "staticlib/pimpl/forward_macros.hpp"
 #include "staticlib/utils.hpp"
 
+#include "tx_queue.hpp"
+#include "tx_timing.hpp"
+
 namespace wilton {
 namespace serial {
 
+namespace { // anonymous
+
+// retry interval while another process owns the port
+const std::chrono::milliseconds lock_retry_interval = std::chrono::milliseconds(10);
+
+void set_stop_bits(const serial_config& conf, line_settings& ls) {
+    switch(conf.stop_bits_count) {
+    case 1: ls.stop_bits = ONESTOPBIT; break;
+    case 2: ls.stop_bits = TWOSTOPBITS; break;
+    default: throw support::exception(TRACEMSG(
+            "Invalid 'stopBitsCount' specified: [" + sl::support::to_string(conf.byte_size) + "]"));
+    }
+}
+
+void set_parity(const serial_config& conf, line_settings& ls) {
+    switch(conf.parity) {
+    case parity_type::none: {
+        ls.parity = NOPARITY;
+        ls.parity_check = false;
+        break;
+    }
+    case parity_type::even: {
+        ls.parity = EVENPARITY;
+        ls.parity_check = true;
+        break;
+    }
+    case parity_type::odd: {
+        ls.parity = ODDPARITY;
+        ls.parity_check = true;
+        break;
+    }
+    case parity_type::mark: {
+        ls.parity = MARKPARITY;
+        ls.parity_check = true;
+        break;
+    }
+    case parity_type::space: {
+        ls.parity = SPACEPARITY;
+        ls.parity_check = true;
+        break;
+    }
+    default: throw support::exception(TRACEMSG(
+            "Invalid 'parity' specified: [" + stringify_parity_type(conf.parity) + "]"));
+    }
+}
+
+} // namespace
+
 class connection::impl : public staticlib::pimpl::object::impl {
     serial_config conf;
 
     HANDLE handle = nullptr;
+
+    // data returned back by the caller, consumed before reading from the port
+    std::string unread_data;
+
+    // reused for all receive operations
+    HANDLE rx_event = nullptr;
+    OVERLAPPED rx_overlapped;
+    DWORD rx_event_mask = 0;
+
+    // coalescing transmit queue, only created if enabled in config
+    std::unique_ptr<tx_queue> tx;
+
+    // output lines state cannot be queried, last set values are reported
+    bool dtr_on = false;
+    bool rts_on = false;
  
 public:
     impl(serial_config&& conf) :
     conf(std::move(conf)) {
+        if (this->conf.reconnect) throw support::exception(TRACEMSG(
+                "Serial 'reconnect' is not supported on this platform, port: [" + this->conf.port + "]"));
+        if (nullptr == this->conf.precompiled.get()) {
+            this->conf.precompiled = std::make_shared<const line_settings>(compile_line_settings(this->conf));
+        }
         // oper port
         this->handle = open_com_port();
+        this->rx_event = create_rx_event();
+        std::memset(std::addressof(rx_overlapped), '\0', sizeof (rx_overlapped));
+        rx_overlapped.hEvent = rx_event;
 
         // set params
         DCB dcb;
         std::memset(std::addressof(dcb), '\0', sizeof (dcb));
         load_dcb_params(dcb);
-        dcb.BaudRate = static_cast<DWORD>(this->conf.baud_rate);
-        dcb.ByteSize = static_cast<BYTE>(this->conf.byte_size);
-        set_stop_bits(dcb);
-        set_parity(dcb);
+        this->dtr_on = DTR_CONTROL_DISABLE != dcb.fDtrControl;
+        this->rts_on = RTS_CONTROL_DISABLE != dcb.fRtsControl;
+        auto& ls = *this->conf.precompiled;
+        dcb.BaudRate = static_cast<DWORD>(ls.speed);
+        dcb.ByteSize = static_cast<BYTE>(ls.byte_size);
+        dcb.StopBits = static_cast<BYTE>(ls.stop_bits);
+        dcb.Parity = static_cast<BYTE>(ls.parity);
+        dcb.fParity = ls.parity_check ? TRUE : FALSE;
+        // wake up line readers with EV_RXFLAG
+        dcb.EvtChar = '\n';
+        if (this->conf.rs485) {
+            // driver raises RTS while transmitting, polarity is fixed
+            dcb.fRtsControl = RTS_CONTROL_TOGGLE;
+        }
         apply_dcb_params(dcb);
-        flush_input_buffer();
+        flush_buffers();
+
+        if (this->conf.coalesce_micros > 0) {
+            this->tx.reset(new tx_queue([this](sl::io::span<const char> data) {
+                return this->write_direct(data);
+            }, this->conf.coalesce_micros, this->conf.coalesce_max_bytes));
+        }
     }
 
     ~impl() STATICLIB_NOEXCEPT {
+        // queued data must be written before the port is closed
+        tx.reset();
         if (nullptr != handle) {
             ::CloseHandle(handle);
         }
+        if (nullptr != rx_event) {
+            ::CloseHandle(rx_event);
+        }
     }
 
     std::string read(connection&, uint32_t length) {
         uint64_t start = sl::utils::current_time_millis_steady();
-        return read_some(start, length, conf.timeout_millis);
+        std::string res;
+        res.resize(length);
+        size_t read = read_some(start, {std::addressof(res.front()), res.length()}, conf.timeout_millis);
+        res.resize(read);
+        return res;
+    }
+
+    uint32_t read_into(connection&, sl::io::span<char> buf) {
+        uint64_t start = sl::utils::current_time_millis_steady();
+        size_t read = read_some(start, buf, conf.timeout_millis);
+        return static_cast<uint32_t>(read);
+    }
+
+    uint32_t read_available(connection&, sl::io::span<char> buf, uint32_t timeout_millis) {
+        uint64_t start = sl::utils::current_time_millis_steady();
+        size_t read = read_some(start, buf, timeout_millis, true);
+        return static_cast<uint32_t>(read);
     }
 
     std::string read_line(connection&) {
@@ -74,13 +189,25 @@ public:
         uint64_t finish = start + conf.timeout_millis;
         uint64_t cur = start;
         std::string res;
+        std::array<char, 256> buf;
         for(;;) {
             uint32_t passed = static_cast<uint32_t> (cur - start);
-            auto ch = this->read_some(cur, 1, conf.timeout_millis - passed);
-            if (ch.empty() || '\n' == ch.at(0)) {
+            auto read = this->read_some(cur, {buf.data(), buf.size()}, conf.timeout_millis - passed, true);
+            if (0 == read) {
+                break;
+            }
+            auto nl = static_cast<const char*>(std::memchr(buf.data(), '\n', read));
+            if (nullptr != nl) {
+                size_t line_len = static_cast<size_t>(nl - buf.data());
+                res.append(buf.data(), line_len);
+                // keep the data after the line end for the next read
+                size_t rest = read - line_len - 1;
+                if (rest > 0) {
+                    unread_data.insert(0, nl + 1, rest);
+                }
                 break;
             }
-            res.push_back(ch.at(0));
+            res.append(buf.data(), read);
             cur = sl::utils::current_time_millis_steady();
             if (cur >= finish) {
                 break;
@@ -93,6 +220,151 @@ public:
     }
 
     uint32_t write(connection&, sl::io::span<const char> data) {
+        if (nullptr != tx.get()) {
+            return tx->write(data);
+        }
+        return write_direct(data);
+    }
+
+    void flush(connection&) {
+        if (nullptr != tx.get()) {
+            tx->flush();
+        }
+    }
+
+    void drain(connection& frontend) {
+        flush(frontend);
+        auto err = ::FlushFileBuffers(this->handle);
+        if (0 == err) throw support::exception(TRACEMSG(
+                "Serial 'FlushFileBuffers' error, port: [" + this->conf.port + "]," +
+                " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+    }
+
+    uint32_t write_drain(connection& frontend, sl::io::span<const char> data) {
+        flush(frontend);
+        if (conf.rs485) {
+            sleep_until_precise(std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(conf.rs485_delay_before_send_millis));
+        }
+        auto start = std::chrono::steady_clock::now();
+        uint32_t written = write_direct(data);
+        drain(frontend);
+        // FlushFileBuffers may return while the last bytes are still in the UART FIFO
+        sleep_until_precise(start + transmit_time(conf, written));
+        if (conf.rs485) {
+            sleep_until_precise(std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(conf.rs485_delay_after_send_millis));
+        }
+        return written;
+    }
+
+    void unread(connection&, sl::io::span<const char> data) {
+        unread_data.insert(0, data.data(), data.size());
+    }
+
+    sl::json::value modem_lines(connection&) {
+        DWORD status = modem_status();
+        return {
+            { "DTR", dtr_on },
+            { "RTS", rts_on },
+            { "CTS", 0 != (status & MS_CTS_ON) },
+            { "DSR", 0 != (status & MS_DSR_ON) },
+            { "DCD", 0 != (status & MS_RLSD_ON) },
+            { "RI", 0 != (status & MS_RING_ON) }
+        };
+    }
+
+    void set_modem_line(connection&, modem_line line, bool value) {
+        DWORD func = 0;
+        switch (line) {
+        case modem_line::dtr: func = value ? SETDTR : CLRDTR; break;
+        case modem_line::rts: func = value ? SETRTS : CLRRTS; break;
+        default: throw support::exception(TRACEMSG(
+                "Input modem line cannot be set: [" + stringify_modem_line(line) + "]"));
+        }
+        auto err = ::EscapeCommFunction(this->handle, func);
+        if (0 == err) throw support::exception(TRACEMSG(
+                "Serial 'EscapeCommFunction' error, port: [" + this->conf.port + "]," +
+                " line: [" + stringify_modem_line(line) + "]," +
+                " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+        if (modem_line::dtr == line) {
+            this->dtr_on = value;
+        } else {
+            this->rts_on = value;
+        }
+    }
+
+    void send_break(connection& frontend, uint32_t duration_millis) {
+        // break starts after the pending output is sent
+        drain(frontend);
+        auto err = ::SetCommBreak(this->handle);
+        if (0 == err) throw support::exception(TRACEMSG(
+                "Serial 'SetCommBreak' error, port: [" + this->conf.port + "]," +
+                " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+        std::this_thread::sleep_for(std::chrono::milliseconds(duration_millis > 0 ? duration_millis : 250));
+        err = ::ClearCommBreak(this->handle);
+        if (0 == err) throw support::exception(TRACEMSG(
+                "Serial 'ClearCommBreak' error, port: [" + this->conf.port + "]," +
+                " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+    }
+
+    // comm event mask is used by the reads, so the lines are polled
+    bool wait_modem_change(connection&, const std::vector<modem_line>& lines, uint32_t timeout_millis,
+            std::mutex& io_mutex) {
+        DWORD mask = 0;
+        for (modem_line ml : lines) {
+            switch (ml) {
+            case modem_line::cts: mask |= MS_CTS_ON; break;
+            case modem_line::dsr: mask |= MS_DSR_ON; break;
+            case modem_line::dcd: mask |= MS_RLSD_ON; break;
+            case modem_line::ri: mask |= MS_RING_ON; break;
+            default: throw support::exception(TRACEMSG(
+                    "Output modem line cannot be waited for: [" + stringify_modem_line(ml) + "]"));
+            }
+        }
+        uint32_t timeout = timeout_millis > 0 ? timeout_millis : conf.timeout_millis;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+        DWORD initial = 0;
+        {
+            std::lock_guard<std::mutex> guard{io_mutex};
+            initial = modem_status() & mask;
+        }
+        while (std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(conf.modem_poll_millis));
+            // lock is held for the poll only, not for the sleep
+            std::lock_guard<std::mutex> guard{io_mutex};
+            if ((modem_status() & mask) != initial) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const serial_config& config(const connection&) const {
+        return conf;
+    }
+
+    int poll_fd(const connection&) const {
+        // receive event is armed by WaitCommEvent inside the read, there is no descriptor to poll
+        return -1;
+    }
+
+    bool has_unread(const connection&) const {
+        return !unread_data.empty();
+    }
+
+    sl::json::value status(const connection&) const {
+        return {
+            { "port", conf.port },
+            { "reopenPath", conf.port },
+            { "connected", true },
+            { "reconnectsCount", 0 },
+            { "rs485Mode", conf.rs485 ? "DRIVER" : "DISABLED" }
+        };
+    }
+
+private:
+    uint32_t write_direct(sl::io::span<const char> data) {
         uint64_t start = sl::utils::current_time_millis_steady();
         uint64_t finish = start + conf.timeout_millis;
         uint64_t cur = start;
@@ -190,170 +462,189 @@ public:
         return static_cast<uint32_t>(written);
     }
 
-private:
 
-    std::string read_some(uint64_t start, uint32_t length, uint32_t timeout_millis) {
+    size_t take_unread(sl::io::span<char> buf) {
+        if (unread_data.empty()) {
+            return 0;
+        }
+        size_t len = std::min(buf.size(), unread_data.length());
+        std::memcpy(buf.data(), unread_data.data(), len);
+        unread_data.erase(0, len);
+        return len;
+    }
+
+    size_t read_some(uint64_t start, sl::io::span<char> buf, uint32_t timeout_millis,
+            bool return_partial = false) {
         uint64_t finish = start + timeout_millis;
-        uint64_t cur = start;
-        std::string res;
+        // reply is expected to the queued request, no need to wait for the window
+        if (nullptr != tx.get()) {
+            tx->flush();
+        }
+        size_t filled = take_unread(buf);
+        if (filled >= buf.size() || (return_partial && filled > 0)) {
+            return filled;
+        }
         for (;;) {
-            bool completion_called_flag = false;
-            // (err, bytes_read, flag)
-            std::tuple<DWORD, DWORD, bool*> state = std::make_tuple(0, 0, std::addressof(completion_called_flag));
-            OVERLAPPED overlapped;
-            std::memset(std::addressof(overlapped), '\0', sizeof (overlapped)); 
-            overlapped.hEvent = static_cast<void*>(std::addressof(state));
+            // take everything the driver has buffered
+            filled += read_buffered({buf.data() + filled, buf.size() - filled});
+            if (filled >= buf.size() || (return_partial && filled > 0)) {
+                break;
+            }
 
-            // completion routine
-            auto completion = static_cast<LPOVERLAPPED_COMPLETION_ROUTINE> ([](
-                    DWORD err, DWORD bytes_read, LPOVERLAPPED overlapped_ptr) {
-                auto state_ptr = static_cast<std::tuple<DWORD, DWORD, bool*>*>(overlapped_ptr->hEvent);
-                std::get<0>(*state_ptr) = err;
-                std::get<1>(*state_ptr) = bytes_read;
-                *std::get<2>(*state_ptr) = true;
-            });
+            // check timeout
+            uint64_t cur = sl::utils::current_time_millis_steady();
+            if (cur >= finish) {
+                break;
+            }
 
-            // find out how much data is buffered
-            DWORD flags = 0;
-            COMSTAT comstat;
-            std::memset(std::addressof(comstat), '\0', sizeof(comstat));
-            auto err_clear = ::ClearCommError(this->handle, std::addressof(flags), std::addressof(comstat));
-            if (0 == err_clear) throw support::exception(TRACEMSG(
-                    "Serial 'ClearCommError' error, port: [" + this->conf.port + "]," +
-                    " bytes to read: [" + sl::support::to_string(length) + "]" +
-                    " bytes read: [" + sl::support::to_string(res.length()) + "]" +
-                    " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
-            size_t avail = static_cast<size_t>(comstat.cbInQue);
+            // sleep until new data arrives
+            wait_rx_event(static_cast<DWORD>(finish - cur), buf.size(), filled);
+        }
+        return filled;
+    }
 
-            // prepare read
-            uint32_t passed = static_cast<uint32_t> (cur - start);
-            int rtm = static_cast<int> (timeout_millis - passed);
-            auto prev_len = res.length();
-            // default to 1 byte, if no data is available
-            size_t rlen = avail > 0 ? avail : 1;
-            auto max_rlen = length - prev_len;
-            if (rlen > max_rlen) {
-                rlen = max_rlen;
-            }
-            res.resize(prev_len + rlen);
+    size_t read_buffered(sl::io::span<char> dest) {
+        // completes immediately with the buffered data, see COMMTIMEOUTS in open_com_port
+        auto err_read = ::ReadFile(
+                this->handle,
+                static_cast<void*> (dest.data()),
+                static_cast<DWORD> (dest.size()),
+                nullptr,
+                std::addressof(rx_overlapped));
+        if (0 == err_read && ERROR_IO_PENDING != ::GetLastError()) throw support::exception(TRACEMSG(
+                "Serial 'ReadFile' error, port: [" + this->conf.port + "]," +
+                " bytes to read: [" + sl::support::to_string(dest.size()) + "]" +
+                " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+        DWORD read = 0;
+        auto err_get = ::GetOverlappedResult(
+                this->handle,
+                std::addressof(rx_overlapped),
+                std::addressof(read),
+                TRUE);
+        if (0 == err_get) throw support::exception(TRACEMSG(
+                "Serial 'GetOverlappedResult' error, port: [" + this->conf.port + "]," +
+                " bytes to read: [" + sl::support::to_string(dest.size()) + "]" +
+                " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+        return static_cast<size_t>(read);
+    }
 
-            // start read
-            auto err_read = ::ReadFileEx(
-                    this->handle,
-                    static_cast<void*> (std::addressof(res.front()) + prev_len),
-                    static_cast<DWORD> (rlen),
-                    std::addressof(overlapped),
-                    completion); 
+    void wait_rx_event(DWORD timeout_millis, size_t length, size_t filled) {
+        auto err_wait = ::WaitCommEvent(
+                this->handle,
+                std::addressof(rx_event_mask),
+                std::addressof(rx_overlapped));
+        if (0 != err_wait) {
+            // event is already signaled
+            return;
+        }
+        if (ERROR_IO_PENDING != ::GetLastError()) throw support::exception(TRACEMSG(
+                "Serial 'WaitCommEvent' error, port: [" + this->conf.port + "]," +
+                " bytes to read: [" + sl::support::to_string(length) + "]" +
+                " bytes read: [" + sl::support::to_string(filled) + "]" +
+                " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
 
-            if (0 == err_read) throw support::exception(TRACEMSG(
-                    "Serial 'ReadFileEx' error, port: [" + this->conf.port + "]," +
+        // data may have arrived before the wait was started
+        if (bytes_in_queue(length, filled) > 0) {
+            cancel_rx_wait(length, filled);
+            return;
+        }
+
+        auto err_single = ::WaitForSingleObject(rx_event, timeout_millis);
+        if (WAIT_OBJECT_0 == err_single) {
+            DWORD unused = 0;
+            auto err_get = ::GetOverlappedResult(
+                    this->handle,
+                    std::addressof(rx_overlapped),
+                    std::addressof(unused),
+                    FALSE);
+            if (0 == err_get) throw support::exception(TRACEMSG(
+                    "Serial 'GetOverlappedResult' error, port: [" + this->conf.port + "]," +
                     " bytes to read: [" + sl::support::to_string(length) + "]" +
-                    " bytes read: [" + sl::support::to_string(res.length()) + "]" +
-                    " bytes avail: [" + sl::support::to_string(avail) + "]" +
+                    " bytes read: [" + sl::support::to_string(filled) + "]" +
                     " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+        } else if (WAIT_TIMEOUT == err_single) {
+            cancel_rx_wait(length, filled);
+        } else throw support::exception(TRACEMSG(
+                "Serial 'WaitForSingleObject' error, port: [" + this->conf.port + "]," +
+                " bytes to read: [" + sl::support::to_string(length) + "]" +
+                " bytes read: [" + sl::support::to_string(filled) + "]" +
+                " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+    }
 
-            auto err_wait_read = ::SleepEx(rtm, TRUE);
-            if (WAIT_IO_COMPLETION != err_wait_read || !completion_called_flag) {
-                // cancel pending operation
-                auto err_cancel = ::CancelIo(this->handle);
-                if (0 == err_cancel) throw support::exception(TRACEMSG(
-                        "Serial 'CancelIo' error, port: [" + this->conf.port + "]," +
-                        " bytes to read: [" + sl::support::to_string(length) + "]" +
-                        " bytes read: [" + sl::support::to_string(res.length()) + "]" +
-                        " bytes avail: [" + sl::support::to_string(avail) + "]" +
-                        " completion called: [" + sl::support::to_string(completion_called_flag) + "]" +
-                        " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
-                // wait for operation to be canceled
-                auto err_wait_canceled = ::SleepEx(INFINITE, TRUE);
-                if (WAIT_IO_COMPLETION != err_wait_canceled || !completion_called_flag) throw support::exception(TRACEMSG(
-                        "Serial 'SleepEx' error, port: [" + this->conf.port + "]," +
-                        " bytes to read: [" + sl::support::to_string(length) + "]" +
-                        " bytes read: [" + sl::support::to_string(res.length()) + "]" +
-                        " bytes avail: [" + sl::support::to_string(avail) + "]" +
-                        " completion called: [" + sl::support::to_string(completion_called_flag) + "]" +
-                        " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
-            }
-
-            // at this point completion routine must be called
-            if (ERROR_SUCCESS == std::get<0>(state)) {
-                // check for warnings
-                DWORD read_checked = 0;
-                overlapped.hEvent = 0;
-                auto err_get = ::GetOverlappedResult(
-                        this->handle,
-                        std::addressof(overlapped),
-                        std::addressof(read_checked),
-                        TRUE);
-                if (0 == err_get) throw support::exception(TRACEMSG(
-                        "Serial 'GetOverlappedResult' error, port: [" + this->conf.port + "]," +
-                        " bytes to read: [" + sl::support::to_string(length) + "]" +
-                        " bytes read: [" + sl::support::to_string(res.length()) + "]" +
-                        " bytes avail: [" + sl::support::to_string(avail) + "]" +
-                        " bytes completion: [" + sl::support::to_string(std::get<1>(state)) + "]" +
-                        " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
-                
-                auto read = static_cast<size_t>(read_checked > std::get<1>(state) ? read_checked : std::get<1>(state));
-                if (read != rlen) {
-                    if (read < rlen) {
-                        res.resize(prev_len + read);
-                    } else throw support::exception(TRACEMSG(
-                        "Serial 'GetOverlappedResult' read_checked error, port: [" + this->conf.port + "]," +
-                        " bytes rlen: [" + sl::support::to_string(length) + "]" +
-                        " bytes read_checked: [" + sl::support::to_string(read_checked) + "]" +
-                        " bytes avail: [" + sl::support::to_string(avail) + "]" +
-                        " bytes completion: [" + sl::support::to_string(std::get<1>(state)) + "]"));
-                }
-                if (res.length() >= length) {
-                    break;
-                }
-            } else if (ERROR_OPERATION_ABORTED == std::get<0>(state)) {
-                res.resize(prev_len);
-            } else throw support::exception(TRACEMSG(
-                    "Serial 'FileIOCompletionRoutine' error, port: [" + this->conf.port + "]," +
-                    " bytes to read: [" + sl::support::to_string(length) + "]" +
-                    " bytes read: [" + sl::support::to_string(res.length()) + "]" +
-                    " bytes avail: [" + sl::support::to_string(avail) + "]" +
-                    " error: [" + sl::utils::errcode_to_string(std::get<0>(state)) + "]"));
+    void cancel_rx_wait(size_t length, size_t filled) {
+        auto err_cancel = ::CancelIo(this->handle);
+        if (0 == err_cancel) throw support::exception(TRACEMSG(
+                "Serial 'CancelIo' error, port: [" + this->conf.port + "]," +
+                " bytes to read: [" + sl::support::to_string(length) + "]" +
+                " bytes read: [" + sl::support::to_string(filled) + "]" +
+                " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+        // wait for operation to be canceled, ERROR_OPERATION_ABORTED is expected here
+        DWORD unused = 0;
+        ::GetOverlappedResult(
+                this->handle,
+                std::addressof(rx_overlapped),
+                std::addressof(unused),
+                TRUE);
+    }
 
-            // check timeout
-            cur = sl::utils::current_time_millis_steady();
-            if (cur >= finish) {
-                break;
-            }
-        }
-        return res;
+    size_t bytes_in_queue(size_t length, size_t filled) {
+        // also clears the error flags reported with EV_ERR
+        DWORD flags = 0;
+        COMSTAT comstat;
+        std::memset(std::addressof(comstat), '\0', sizeof(comstat));
+        auto err_clear = ::ClearCommError(this->handle, std::addressof(flags), std::addressof(comstat));
+        if (0 == err_clear) throw support::exception(TRACEMSG(
+                "Serial 'ClearCommError' error, port: [" + this->conf.port + "]," +
+                " bytes to read: [" + sl::support::to_string(length) + "]" +
+                " bytes read: [" + sl::support::to_string(filled) + "]" +
+                " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+        return static_cast<size_t>(comstat.cbInQue);
     }
 
     HANDLE open_com_port() {
         // open port
         auto wport = sl::utils::widen(this->conf.port);
-        HANDLE handle = ::CreateFileW(wport.c_str(),
-                GENERIC_READ | GENERIC_WRITE,
-                0,
-                0,
-                OPEN_EXISTING,
-                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED,
-                nullptr); 
+        // comm ports are always opened without sharing, only waiting for the owner is optional
+        uint64_t finish = sl::utils::current_time_millis_steady() + this->conf.exclusive_wait_millis;
+        HANDLE handle = INVALID_HANDLE_VALUE;
+        for (;;) {
+            handle = ::CreateFileW(wport.c_str(),
+                    GENERIC_READ | GENERIC_WRITE,
+                    0,
+                    0,
+                    OPEN_EXISTING,
+                    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED,
+                    nullptr);
+            if (INVALID_HANDLE_VALUE != handle || !port_busy(::GetLastError()) ||
+                    sl::utils::current_time_millis_steady() >= finish) {
+                break;
+            }
+            std::this_thread::sleep_for(lock_retry_interval);
+        }
         if (INVALID_HANDLE_VALUE == handle) throw support::exception(TRACEMSG(
                 "Serial 'CreateFileW' error, port: [" + this->conf.port + "],"
                 " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
 
-        // setup a 4k buffer
-        auto err_setup = ::SetupComm(handle, 4096, 4096);
+        // driver may round the sizes or ignore them
+        auto err_setup = ::SetupComm(handle, static_cast<DWORD>(this->conf.rx_queue_size),
+                static_cast<DWORD>(this->conf.tx_queue_size));
         if (0 == err_setup) throw support::exception(TRACEMSG(
                 "Serial 'SetupComm' error, port: [" + this->conf.port + "],"
+                " rx queue size: [" + sl::support::to_string(this->conf.rx_queue_size) + "],"
+                " tx queue size: [" + sl::support::to_string(this->conf.tx_queue_size) + "],"
                 " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
 
-        // disable timeouts
+        // reads return buffered data immediately, writes have no timeouts
         COMMTIMEOUTS timeouts;
         std::memset(std::addressof(timeouts), '\0', sizeof(timeouts));
+        timeouts.ReadIntervalTimeout = MAXDWORD;
         auto err_timeouts = ::SetCommTimeouts(handle, std::addressof(timeouts));
         if (0 == err_timeouts) throw support::exception(TRACEMSG(
                 "Serial 'SetCommTimeouts' error, port: [" + this->conf.port + "],"
                 " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
 
         // set events
-        auto err_mask = ::SetCommMask(handle, EV_ERR);
+        auto err_mask = ::SetCommMask(handle, EV_RXCHAR | EV_RXFLAG | EV_ERR);
         if (0 == err_mask) throw support::exception(TRACEMSG(
                 "Serial 'SetCommMask' error, port: [" + this->conf.port + "],"
                 " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
@@ -361,6 +652,19 @@ private:
         return handle;
     }
 
+    static bool port_busy(DWORD code) {
+        return ERROR_ACCESS_DENIED == code || ERROR_SHARING_VIOLATION == code;
+    }
+
+    HANDLE create_rx_event() {
+        // manual reset, as required for overlapped operations
+        HANDLE event = ::CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        if (nullptr == event) throw support::exception(TRACEMSG(
+                "Serial 'CreateEventW' error, port: [" + this->conf.port + "],"
+                " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+        return event;
+    }
+
     void load_dcb_params(DCB& dcb) {
         auto err = ::GetCommState(this->handle, std::addressof(dcb)); 
         if (0 == err) throw support::exception(TRACEMSG(
@@ -368,47 +672,6 @@ private:
                 " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
     }
 
-    void set_stop_bits(DCB& dcb) {
-        switch(conf.stop_bits_count) {
-        case 1: dcb.StopBits = ONESTOPBIT; break;
-        case 2: dcb.StopBits = TWOSTOPBITS; break;
-        default: throw support::exception(TRACEMSG(
-                "Invalid 'stopBitsCount' specified: [" + sl::support::to_string(conf.byte_size) + "]"));
-        }
-    }
-
-    void set_parity(DCB& dcb) {
-        switch(conf.parity) {
-        case parity_type::none: {
-            dcb.Parity = NOPARITY;
-            dcb.fParity = FALSE;
-            break;
-        }
-        case parity_type::even: {
-            dcb.Parity = EVENPARITY;
-            dcb.fParity = TRUE;
-            break;
-        }
-        case parity_type::odd: {
-            dcb.Parity = ODDPARITY;
-            dcb.fParity = TRUE;
-            break;
-        }
-        case parity_type::mark: {
-            dcb.Parity = MARKPARITY;
-            dcb.fParity = TRUE;
-            break;
-        }
-        case parity_type::space: {
-            dcb.Parity = SPACEPARITY;
-            dcb.fParity = TRUE;
-            break;
-        }
-        default: throw support::exception(TRACEMSG(
-                "Invalid 'parity' specified: [" + stringify_parity_type(conf.parity) + "]"));
-        }
-    }
-
     void apply_dcb_params(DCB& dcb) {
         auto err = ::SetCommState(this->handle, std::addressof(dcb));
         if (0 == err) throw support::exception(TRACEMSG(
@@ -416,19 +679,60 @@ private:
                 " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
     }
 
-    void flush_input_buffer() {
-        auto err = ::PurgeComm(this->handle,
-                PURGE_TXCLEAR | PURGE_TXABORT | PURGE_RXCLEAR | PURGE_RXABORT);
+    DWORD modem_status() {
+        DWORD status = 0;
+        auto err = ::GetCommModemStatus(this->handle, std::addressof(status));
+        if (0 == err) throw support::exception(TRACEMSG(
+                "Serial 'GetCommModemStatus' error, port: [" + this->conf.port + "]," +
+                " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+        return status;
+    }
+
+    void flush_buffers() {
+        DWORD flags = 0;
+        switch (conf.flush_on_open) {
+        case flush_type::none: return;
+        case flush_type::input: flags = PURGE_RXCLEAR | PURGE_RXABORT; break;
+        case flush_type::output: flags = PURGE_TXCLEAR | PURGE_TXABORT; break;
+        case flush_type::both: flags = PURGE_TXCLEAR | PURGE_TXABORT | PURGE_RXCLEAR | PURGE_RXABORT; break;
+        default: throw support::exception(TRACEMSG("Invalid flush type: [" +
+                stringify_flush_type(conf.flush_on_open) + "]"));
+        }
+        auto err = ::PurgeComm(this->handle, flags);
         if (0 == err) throw support::exception(TRACEMSG(
                 "Serial 'PurgeComm' error, port: [" + this->conf.port + "],"
                 " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
     }
 
 };
+
+line_settings compile_line_settings(const serial_config& conf) {
+    line_settings res;
+    res.speed = conf.baud_rate;
+    res.byte_size = static_cast<uint8_t>(conf.byte_size);
+    set_stop_bits(conf, res);
+    set_parity(conf, res);
+    return res;
+}
+
 PIMPL_FORWARD_CONSTRUCTOR(connection, (serial_config&&), (), support::exception)
 PIMPL_FORWARD_METHOD(connection, std::string, read, (uint32_t), (), support::exception)
+PIMPL_FORWARD_METHOD(connection, uint32_t, read_into, (sl::io::span<char>), (), support::exception)
+PIMPL_FORWARD_METHOD(connection, uint32_t, read_available, (sl::io::span<char>)(uint32_t), (), support::exception)
 PIMPL_FORWARD_METHOD(connection, std::string, read_line, (), (), support::exception)
 PIMPL_FORWARD_METHOD(connection, uint32_t, write, (sl::io::span<const char>), (), support::exception)
+PIMPL_FORWARD_METHOD(connection, void, flush, (), (), support::exception)
+PIMPL_FORWARD_METHOD(connection, void, drain, (), (), support::exception)
+PIMPL_FORWARD_METHOD(connection, uint32_t, write_drain, (sl::io::span<const char>), (), support::exception)
+PIMPL_FORWARD_METHOD(connection, void, unread, (sl::io::span<const char>), (), support::exception)
+PIMPL_FORWARD_METHOD(connection, sl::json::value, modem_lines, (), (), support::exception)
+PIMPL_FORWARD_METHOD(connection, void, set_modem_line, (modem_line)(bool), (), support::exception)
+PIMPL_FORWARD_METHOD(connection, void, send_break, (uint32_t), (), support::exception)
+PIMPL_FORWARD_METHOD(connection, bool, wait_modem_change, (const std::vector<modem_line>&)(uint32_t)(std::mutex&), (), support::exception)
+PIMPL_FORWARD_METHOD(connection, const serial_config&, config, (), (const), support::exception)
+PIMPL_FORWARD_METHOD(connection, int, poll_fd, (), (const), support::exception)
+PIMPL_FORWARD_METHOD(connection, bool, has_unread, (), (const), support::exception)
+PIMPL_FORWARD_METHOD(connection, sl::json::value, status, (), (const), support::exception)
 
 } // namespace
 }
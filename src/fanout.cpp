@@ -0,0 +1,190 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   fanout.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 04:38 PM
+ */
+
+#include "fanout.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "wilton/support/exception.hpp"
+
+namespace wilton {
+namespace serial {
+
+namespace { // anonymous
+
+// max time the I/O mutex is held by a single port read
+const uint32_t pump_slice_millis = 50;
+
+} // namespace
+
+fanout::fanout(connection& conn, std::mutex& io_mutex, uint32_t capacity) :
+conn(conn),
+io_mutex(io_mutex),
+ring(capacity) { }
+
+uint32_t fanout::subscribe(overflow_policy policy) {
+    std::lock_guard<std::mutex> guard{mutex};
+    if (closed) throw support::exception(TRACEMSG("Serial connection is closed"));
+    for (size_t i = 0; i < subscribers.size(); i++) {
+        if (!subscribers[i].active) {
+            subscribers[i] = subscriber(head, policy);
+            return static_cast<uint32_t>(i);
+        }
+    }
+    subscribers.emplace_back(head, policy);
+    return static_cast<uint32_t>(subscribers.size() - 1);
+}
+
+void fanout::unsubscribe(uint32_t id) {
+    std::lock_guard<std::mutex> guard{mutex};
+    find_subscriber(id).active = false;
+    // blocked port reads may proceed now
+    cv.notify_all();
+}
+
+bool fanout::has_subscribers() {
+    std::lock_guard<std::mutex> guard{mutex};
+    if (pumping) {
+        return true;
+    }
+    for (auto& sub : subscribers) {
+        if (sub.active) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t fanout::read(uint32_t id, sl::io::span<char> buf, uint32_t timeout_millis) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_millis);
+    std::unique_lock<std::mutex> guard{mutex};
+    for (;;) {
+        if (closed) throw support::exception(TRACEMSG("Serial connection is closed"));
+        auto& sub = find_subscriber(id);
+        if (sub.cursor < head) {
+            return copy_out(sub, buf);
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return 0;
+        }
+        uint64_t space = free_space();
+        if (pumping || 0 == space) {
+            // wait for the other subscriber to read the port, or for the lagging one to consume
+            cv.wait_until(guard, deadline);
+            continue;
+        }
+        // read the port directly into the ring, outside of the lock
+        size_t offset = static_cast<size_t>(head % ring.size());
+        size_t len = static_cast<size_t>(std::min(space, static_cast<uint64_t>(ring.size() - offset)));
+        auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now);
+        uint32_t slice = std::min(static_cast<uint32_t>(wait.count()), pump_slice_millis);
+        pumping = true;
+        overwrite_bound = head + len > ring.size() ? head + len - ring.size() : 0;
+        guard.unlock();
+        uint32_t read = 0;
+        try {
+            std::lock_guard<std::mutex> io_guard{io_mutex};
+            read = conn.read_available({ring.data() + offset, len}, slice);
+        } catch (...) {
+            guard.lock();
+            pumping = false;
+            overwrite_bound = 0;
+            cv.notify_all();
+            throw;
+        }
+        guard.lock();
+        pumping = false;
+        overwrite_bound = 0;
+        head += read;
+        cv.notify_all();
+    }
+}
+
+sl::json::value fanout::status(uint32_t id) {
+    std::lock_guard<std::mutex> guard{mutex};
+    auto& sub = find_subscriber(id);
+    uint64_t lower = head > ring.size() ? head - ring.size() : 0;
+    uint64_t pending = head - std::max(sub.cursor, lower);
+    return {
+        { "overflowPolicy", stringify_overflow_policy(sub.policy) },
+        { "bytesPending", pending },
+        { "bytesDropped", sub.dropped }
+    };
+}
+
+void fanout::close() {
+    std::unique_lock<std::mutex> guard{mutex};
+    closed = true;
+    cv.notify_all();
+    cv.wait(guard, [this] {
+        return !pumping;
+    });
+}
+
+fanout::subscriber& fanout::find_subscriber(uint32_t id) {
+    if (id >= subscribers.size() || !subscribers[id].active) throw support::exception(TRACEMSG(
+            "Invalid subscriber ID specified: [" + sl::support::to_string(id) + "]"));
+    return subscribers[id];
+}
+
+uint32_t fanout::copy_out(subscriber& sub, sl::io::span<char> buf) {
+    // oldest data may be already overwritten
+    uint64_t lower = head > ring.size() ? head - ring.size() : 0;
+    lower = std::max(lower, overwrite_bound);
+    if (sub.cursor < lower) {
+        sub.dropped += lower - sub.cursor;
+        sub.cursor = lower;
+    }
+    size_t avail = static_cast<size_t>(head - sub.cursor);
+    size_t len = std::min(avail, buf.size());
+    size_t offset = static_cast<size_t>(sub.cursor % ring.size());
+    size_t first = std::min(len, ring.size() - offset);
+    std::memcpy(buf.data(), ring.data() + offset, first);
+    if (len > first) {
+        std::memcpy(buf.data() + first, ring.data(), len - first);
+    }
+    sub.cursor += len;
+    // space freed for the blocked port reads
+    cv.notify_all();
+    return static_cast<uint32_t>(len);
+}
+
+uint64_t fanout::free_space() {
+    uint64_t min_cursor = head;
+    for (auto& sub : subscribers) {
+        if (sub.active && overflow_policy::block == sub.policy) {
+            min_cursor = std::min(min_cursor, sub.cursor);
+        }
+    }
+    return ring.size() - (head - min_cursor);
+}
+
+} // namespace
+}
+
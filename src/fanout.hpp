@@ -0,0 +1,147 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   fanout.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 04:35 PM
+ */
+
+#ifndef WILTON_SERIAL_FANOUT_HPP
+#define WILTON_SERIAL_FANOUT_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+#include "staticlib/json.hpp"
+
+#include "connection.hpp"
+#include "overflow_policy.hpp"
+
+namespace wilton {
+namespace serial {
+
+/**
+ * Shares the received data between multiple subscribers: data is read
+ * from the port once into the shared ring buffer, each subscriber
+ * has its own cursor in it; the port is read by the subscriber
+ * that has consumed all the available data
+ *
+ * Port reads are done under the connection I/O mutex in short slices,
+ * so direct writes can go in between; direct reads must be rejected
+ * by the caller while there are subscribers.
+ */
+class fanout {
+    class subscriber {
+    public:
+        uint64_t cursor;
+        overflow_policy policy;
+        uint64_t dropped = 0;
+        bool active = true;
+
+        subscriber(uint64_t cursor, overflow_policy policy) :
+        cursor(cursor),
+        policy(policy) { }
+    };
+
+    connection& conn;
+    std::mutex& io_mutex;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<char> ring;
+    // total number of bytes received
+    uint64_t head = 0;
+    // data below this position is being overwritten by the port read
+    uint64_t overwrite_bound = 0;
+    bool pumping = false;
+    bool closed = false;
+    std::vector<subscriber> subscribers;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param conn connection, must be valid until `close` is called
+     * @param io_mutex mutex that serializes the calls to the connection
+     * @param capacity ring buffer size
+     */
+    fanout(connection& conn, std::mutex& io_mutex, uint32_t capacity);
+
+    fanout(const fanout&) = delete;
+
+    fanout& operator=(const fanout&) = delete;
+
+    /**
+     * Adds new subscriber, it receives only the data that arrives after this call,
+     * IDs of the unsubscribed ones are reused
+     *
+     * @param policy behaviour when subscriber lags behind by more than the buffer size
+     * @return subscriber ID
+     */
+    uint32_t subscribe(overflow_policy policy);
+
+    void unsubscribe(uint32_t id);
+
+    /**
+     * Checks whether the port is read by the subscribers
+     *
+     * @return true if there are active subscribers or the port read is in progress
+     */
+    bool has_subscribers();
+
+    /**
+     * Reads the data available to the subscriber, waits for the data
+     * if the subscriber consumed everything received so far
+     *
+     * @param id subscriber ID
+     * @param buf destination buffer
+     * @param timeout_millis max time to wait for the data
+     * @return number of bytes read, zero on timeout
+     */
+    uint32_t read(uint32_t id, sl::io::span<char> buf, uint32_t timeout_millis);
+
+    /**
+     * Subscriber state: policy, number of pending and dropped bytes
+     *
+     * @param id subscriber ID
+     * @return status JSON
+     */
+    sl::json::value status(uint32_t id);
+
+    /**
+     * Detaches from the connection, waits for the port read in progress,
+     * subsequent reads throw
+     */
+    void close();
+
+private:
+    subscriber& find_subscriber(uint32_t id);
+
+    uint32_t copy_out(subscriber& sub, sl::io::span<char> buf);
+
+    uint64_t free_space();
+};
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_FANOUT_HPP */
+
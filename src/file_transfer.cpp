@@ -0,0 +1,164 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   file_transfer.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 11:42 AM
+ */
+
+#include "file_transfer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+#include "staticlib/tinydir.hpp"
+
+#include "wilton/support/exception.hpp"
+
+#include "connection_io.hpp"
+
+namespace wilton {
+namespace serial {
+
+namespace { // anonymous
+
+// streaming KMP matcher, state survives chunk boundaries
+class terminator_matcher {
+    const std::string& pattern;
+    std::vector<size_t> fallback;
+    size_t matched = 0;
+
+public:
+    terminator_matcher(const std::string& pattern) :
+    pattern(pattern) {
+        fallback.resize(pattern.length() + 1);
+        size_t k = 0;
+        for (size_t i = 1; i < pattern.length(); i++) {
+            while (k > 0 && pattern[i] != pattern[k]) {
+                k = fallback[k];
+            }
+            if (pattern[i] == pattern[k]) {
+                k += 1;
+            }
+            fallback[i + 1] = k;
+        }
+    }
+
+    // returns the length of data up to and including the terminator,
+    // or npos if terminator was not found
+    size_t find_end(const char* data, size_t len) {
+        if (pattern.empty()) {
+            return std::string::npos;
+        }
+        for (size_t i = 0; i < len; i++) {
+            while (matched > 0 && data[i] != pattern[matched]) {
+                matched = fallback[matched];
+            }
+            if (data[i] == pattern[matched]) {
+                matched += 1;
+            }
+            if (pattern.length() == matched) {
+                return i + 1;
+            }
+        }
+        return std::string::npos;
+    }
+};
+
+size_t chunk_length(uint32_t chunk_size, uint64_t max_bytes, uint64_t done) {
+    if (0 == max_bytes) {
+        return chunk_size;
+    }
+    return static_cast<size_t>(std::min(static_cast<uint64_t>(chunk_size), max_bytes - done));
+}
+
+} // namespace
+
+uint64_t send_file(connection& conn, const std::string& path, uint32_t chunk_size,
+        uint32_t chunk_delay_millis, uint64_t max_bytes) {
+    if (0 == chunk_size) throw support::exception(TRACEMSG(
+            "Invalid 'chunkSize' specified: [" + sl::support::to_string(chunk_size) + "]"));
+    auto src = sl::tinydir::file_source(path);
+    auto sink = make_connection_sink(conn);
+    auto buf = std::string();
+    buf.resize(chunk_size);
+    uint64_t sent = 0;
+    for (;;) {
+        size_t len = chunk_length(chunk_size, max_bytes, sent);
+        if (0 == len) {
+            break;
+        }
+        size_t read = sl::io::read_all(src, {std::addressof(buf.front()), len});
+        if (0 == read) {
+            break;
+        }
+        if (sent > 0 && chunk_delay_millis > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(chunk_delay_millis));
+        }
+        sl::io::write_all(sink, {buf.data(), read});
+        sent += read;
+        if (read < len) {
+            break;
+        }
+    }
+    // tail must not stay in the coalescing queue
+    sink.flush();
+    return sent;
+}
+
+uint64_t receive_to_file(connection& conn, const std::string& path, uint32_t chunk_size,
+        uint64_t max_bytes, const std::string& terminator, uint32_t idle_timeout_millis) {
+    if (0 == chunk_size) throw support::exception(TRACEMSG(
+            "Invalid 'chunkSize' specified: [" + sl::support::to_string(chunk_size) + "]"));
+    auto sink = sl::tinydir::file_sink(path);
+    uint32_t timeout = idle_timeout_millis > 0 ? idle_timeout_millis : conn.config().timeout_millis;
+    auto matcher = terminator_matcher(terminator);
+    auto buf = std::string();
+    buf.resize(chunk_size);
+    uint64_t received = 0;
+    for (;;) {
+        size_t len = chunk_length(chunk_size, max_bytes, received);
+        if (0 == len) {
+            break;
+        }
+        uint32_t read = conn.read_available({std::addressof(buf.front()), len}, timeout);
+        if (0 == read) {
+            break;
+        }
+        size_t end = matcher.find_end(buf.data(), read);
+        size_t keep = std::string::npos != end ? end : read;
+        sl::io::write_all(sink, {buf.data(), keep});
+        received += keep;
+        if (std::string::npos != end) {
+            // leave the data after terminator for the next read
+            if (keep < read) {
+                conn.unread({buf.data() + keep, read - keep});
+            }
+            break;
+        }
+    }
+    sink.flush();
+    return received;
+}
+
+} // namespace
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   file_transfer.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 11:40 AM
+ */
+
+#ifndef WILTON_SERIAL_FILE_TRANSFER_HPP
+#define WILTON_SERIAL_FILE_TRANSFER_HPP
+
+#include <cstdint>
+#include <string>
+
+#include "staticlib/config.hpp"
+
+#include "connection.hpp"
+
+namespace wilton {
+namespace serial {
+
+/**
+ * Streams the contents of the specified file into the connection
+ *
+ * @param conn connection
+ * @param path path to the file
+ * @param chunk_size size of the reused transfer buffer
+ * @param chunk_delay_millis pause between the chunks, zero for no pause
+ * @param max_bytes max number of bytes to send, zero for the whole file
+ * @return number of bytes written
+ */
+uint64_t send_file(connection& conn, const std::string& path, uint32_t chunk_size,
+        uint32_t chunk_delay_millis, uint64_t max_bytes);
+
+/**
+ * Streams the data received from the connection into the specified file,
+ * stops when no data arrives during the idle timeout, when the limit is reached
+ * or after the terminator is received (terminator is written to the file)
+ *
+ * @param conn connection
+ * @param path path to the file, file is overwritten if exists
+ * @param chunk_size size of the reused transfer buffer
+ * @param max_bytes max number of bytes to receive, zero for no limit
+ * @param terminator terminating sequence, empty for no terminator
+ * @param idle_timeout_millis max time to wait for the next chunk,
+ *        connection timeout is used if zero
+ * @return number of bytes written to the file
+ */
+uint64_t receive_to_file(connection& conn, const std::string& path, uint32_t chunk_size,
+        uint64_t max_bytes, const std::string& terminator, uint32_t idle_timeout_millis);
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_FILE_TRANSFER_HPP */
+
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   flush_type.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 09:12 PM
+ */
+
+#include <string>
+
+#include "staticlib/support.hpp"
+
+#include "wilton/support/exception.hpp"
+
+#ifndef WILTON_SERIAL_FLUSH_TYPE_HPP
+#define WILTON_SERIAL_FLUSH_TYPE_HPP
+
+namespace wilton {
+namespace serial {
+
+enum class flush_type {
+    none,
+    input,
+    output,
+    both
+};
+
+inline std::string stringify_flush_type(flush_type ft) {
+    switch (ft) {
+    case flush_type::none: return "NONE";
+    case flush_type::input: return "INPUT";
+    case flush_type::output: return "OUTPUT";
+    case flush_type::both: return "BOTH";
+    default: return "UNKNOWN";
+    }
+}
+
+inline flush_type make_flush_type(const std::string& st) {
+    if ("NONE" == st) {
+        return flush_type::none;
+    } else if ("INPUT" == st) {
+        return flush_type::input;
+    } else if ("OUTPUT" == st) {
+        return flush_type::output;
+    } else if ("BOTH" == st) {
+        return flush_type::both;
+    } else throw support::exception(TRACEMSG("Invalid flush type: [" + st + "]"));
+}
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_FLUSH_TYPE_HPP */
+
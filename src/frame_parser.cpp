@@ -0,0 +1,156 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   frame_parser.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 03:35 PM
+ */
+
+#include "frame_parser.hpp"
+
+#include <array>
+#include <functional>
+#include <utility>
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "wilton/support/exception.hpp"
+
+#include "frame_reader.hpp"
+#include "hex_codec.hpp"
+
+namespace wilton {
+namespace serial {
+
+namespace { // anonymous
+
+template<typename Sync, typename Length, typename Checksum>
+class frame_parser_impl : public frame_parser {
+    frame::frame_reader<Sync, Length, Checksum> reader;
+
+public:
+    explicit frame_parser_impl(size_t max_frame_length) :
+    reader(max_frame_length) { }
+
+    size_t parse(sl::io::span<const char> data, size_t max_frames,
+            std::vector<sl::io::span<const char>>& frames) override {
+        return reader.parse(data.data(), data.size(), [&frames, max_frames](sl::io::span<const char> payload) {
+            frames.emplace_back(payload);
+            return frames.size() < max_frames;
+        });
+    }
+
+    uint64_t bytes_skipped() const override {
+        return reader.bytes_skipped();
+    }
+};
+
+typedef std::function<std::unique_ptr<frame_parser>(size_t)> parser_factory;
+
+template<typename Sync, typename Length, typename Checksum>
+std::pair<std::string, parser_factory> entry(const std::string& name) {
+    return std::make_pair(name, [](size_t max_frame_length) {
+        return std::unique_ptr<frame_parser>(new frame_parser_impl<Sync, Length, Checksum>(max_frame_length));
+    });
+}
+
+const std::vector<std::pair<std::string, parser_factory>>& registry() {
+    static const std::vector<std::pair<std::string, parser_factory>> reg = {
+        entry<frame::no_sync, frame::delimiter_end<'\n'>, frame::no_checksum>("LF"),
+        entry<frame::no_sync, frame::delimiter_end<0x00>, frame::no_checksum>("NUL"),
+        entry<frame::sync_byte<0x02>, frame::delimiter_end<0x03>, frame::no_checksum>("STX_ETX"),
+        entry<frame::sync_byte<0x02>, frame::delimiter_end<0x03>, frame::xor8>("STX_ETX_XOR"),
+        entry<frame::sync_byte<0x02>, frame::delimiter_end<0x03>, frame::sum8>("STX_ETX_SUM"),
+        entry<frame::sync_byte<0xaa>, frame::uint8_length, frame::xor8>("AA_U8_XOR"),
+        entry<frame::sync_byte<0xaa>, frame::uint8_length, frame::sum8>("AA_U8_SUM"),
+        entry<frame::sync_byte<0xaa>, frame::uint8_length, frame::crc8>("AA_U8_CRC8"),
+        entry<frame::sync_byte<0x7e>, frame::uint16le_length, frame::crc16_modbus>("7E_U16LE_CRC16_MODBUS"),
+        entry<frame::sync_byte<0x7e>, frame::uint16be_length, frame::crc16_ccitt>("7E_U16BE_CRC16_CCITT"),
+        entry<frame::no_sync, frame::uint16be_length, frame::crc16_ccitt>("U16BE_CRC16_CCITT"),
+        entry<frame::no_sync, frame::uint16le_length, frame::crc32>("U16LE_CRC32"),
+        entry<frame::no_sync, frame::varint_length, frame::crc32>("VARINT_CRC32"),
+        entry<frame::no_sync, frame::varint_length, frame::no_checksum>("VARINT")
+    };
+    return reg;
+}
+
+} // namespace
+
+std::unique_ptr<frame_parser> make_frame_parser(const std::string& name, size_t max_frame_length) {
+    for (auto& en : registry()) {
+        if (name == en.first) {
+            return en.second(max_frame_length);
+        }
+    }
+    std::string names;
+    for (auto& en : registry()) {
+        names += names.empty() ? en.first : ", " + en.first;
+    }
+    throw support::exception(TRACEMSG("Invalid framing: [" + name + "], supported: [" + names + "]"));
+}
+
+std::vector<std::string> frame_parser_names() {
+    auto res = std::vector<std::string>();
+    for (auto& en : registry()) {
+        res.push_back(en.first);
+    }
+    return res;
+}
+
+sl::json::value read_frames(connection& conn, const std::string& framing, uint32_t max_frames,
+        uint32_t timeout_millis) {
+    auto parser = make_frame_parser(framing, 4096);
+    uint32_t timeout = timeout_millis > 0 ? timeout_millis : conn.config().timeout_millis;
+    uint64_t start = sl::utils::current_time_millis_steady();
+    uint64_t finish = start + timeout;
+    auto res = std::vector<sl::json::value>();
+    std::string data;
+    std::array<char, 1024> buf;
+    auto frames = std::vector<sl::io::span<const char>>();
+    while (res.size() < max_frames) {
+        uint64_t cur = sl::utils::current_time_millis_steady();
+        // after the first frame only the data already received is consumed
+        uint32_t wait = (res.empty() && cur < finish) ? static_cast<uint32_t>(finish - cur) : 0;
+        uint32_t read = conn.read_available({buf.data(), buf.size()}, wait);
+        if (0 == read) {
+            if (!res.empty() || sl::utils::current_time_millis_steady() >= finish) {
+                break;
+            }
+            continue;
+        }
+        data.append(buf.data(), read);
+        frames.clear();
+        size_t consumed = parser->parse({data.data(), data.length()}, max_frames - res.size(), frames);
+        for (auto& fr : frames) {
+            res.emplace_back(hex_encode(fr));
+        }
+        data.erase(0, consumed);
+    }
+    if (data.length() > 0) {
+        conn.unread({data.data(), data.length()});
+    }
+    auto fields = std::vector<sl::json::field>();
+    fields.emplace_back("frames", std::move(res));
+    fields.emplace_back("bytesSkipped", parser->bytes_skipped());
+    return sl::json::value(std::move(fields));
+}
+
+} // namespace
+}
+
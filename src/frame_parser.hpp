@@ -0,0 +1,96 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   frame_parser.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 03:30 PM
+ */
+
+#ifndef WILTON_SERIAL_FRAME_PARSER_HPP
+#define WILTON_SERIAL_FRAME_PARSER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+#include "staticlib/json.hpp"
+
+#include "connection.hpp"
+
+namespace wilton {
+namespace serial {
+
+/**
+ * Type-erased wrapper for the precompiled frame readers
+ */
+class frame_parser {
+public:
+    virtual ~frame_parser() STATICLIB_NOEXCEPT { }
+
+    /**
+     * Parses complete frames from the specified data
+     *
+     * @param data input data
+     * @param max_frames max number of frames to parse
+     * @param frames output payloads, point into the input data
+     * @return number of bytes consumed
+     */
+    virtual size_t parse(sl::io::span<const char> data, size_t max_frames,
+            std::vector<sl::io::span<const char>>& frames) = 0;
+
+    virtual uint64_t bytes_skipped() const = 0;
+};
+
+/**
+ * Creates a parser for one of the named precompiled framings
+ *
+ * @param name framing name, e.g. "STX_ETX_XOR"
+ * @param max_frame_length longer frames are treated as garbage
+ * @return parser
+ */
+std::unique_ptr<frame_parser> make_frame_parser(const std::string& name, size_t max_frame_length);
+
+/**
+ * Names of the precompiled framings
+ *
+ * @return list of names
+ */
+std::vector<std::string> frame_parser_names();
+
+/**
+ * Reads a batch of frames from the connection, waits until at least one frame
+ * is received or the timeout expires; incomplete trailing frame
+ * is returned back to the connection
+ *
+ * @param conn connection
+ * @param framing framing name
+ * @param max_frames max number of frames to return
+ * @param timeout_millis max time to wait for the first frame, connection timeout is used if zero
+ * @return object with "frames" (array of hex payloads) and "bytesSkipped"
+ */
+sl::json::value read_frames(connection& conn, const std::string& framing, uint32_t max_frames,
+        uint32_t timeout_millis);
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_FRAME_PARSER_HPP */
+
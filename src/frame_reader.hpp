@@ -0,0 +1,432 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   frame_reader.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 03:05 PM
+ */
+
+#ifndef WILTON_SERIAL_FRAME_READER_HPP
+#define WILTON_SERIAL_FRAME_READER_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+
+namespace wilton {
+namespace serial {
+namespace frame {
+
+/*
+ * Frame layout: [sync][length][payload][checksum][delimiter],
+ * checksum covers length and payload
+ */
+
+enum class status {
+    ok,
+    need_more,
+    invalid
+};
+
+// sync policies
+
+struct no_sync {
+    static const size_t size = 0;
+
+    static bool matches(const char*) {
+        return true;
+    }
+};
+
+template<uint8_t Byte>
+struct sync_byte {
+    static const size_t size = 1;
+
+    static bool matches(const char* data) {
+        return Byte == static_cast<uint8_t>(data[0]);
+    }
+};
+
+// length policies, report the sizes of the length field, of the payload
+// and of the trailing delimiter
+
+struct uint8_length {
+    static const bool delimited = false;
+
+    static status parse(const char* data, size_t avail, size_t,
+            size_t& header_len, size_t& payload_len, size_t& trailer_len) {
+        if (avail < 1) {
+            return status::need_more;
+        }
+        header_len = 1;
+        payload_len = static_cast<uint8_t>(data[0]);
+        trailer_len = 0;
+        return status::ok;
+    }
+};
+
+template<bool BigEndian>
+struct uint16_length {
+    static const bool delimited = false;
+
+    static status parse(const char* data, size_t avail, size_t,
+            size_t& header_len, size_t& payload_len, size_t& trailer_len) {
+        if (avail < 2) {
+            return status::need_more;
+        }
+        auto b0 = static_cast<uint8_t>(data[0]);
+        auto b1 = static_cast<uint8_t>(data[1]);
+        header_len = 2;
+        payload_len = BigEndian ? ((b0 << 8) | b1) : ((b1 << 8) | b0);
+        trailer_len = 0;
+        return status::ok;
+    }
+};
+
+typedef uint16_length<true> uint16be_length;
+
+typedef uint16_length<false> uint16le_length;
+
+// LEB128, up to 4 bytes
+struct varint_length {
+    static const bool delimited = false;
+
+    static status parse(const char* data, size_t avail, size_t,
+            size_t& header_len, size_t& payload_len, size_t& trailer_len) {
+        size_t val = 0;
+        for (size_t i = 0; i < 4; i++) {
+            if (i >= avail) {
+                return status::need_more;
+            }
+            auto byte = static_cast<uint8_t>(data[i]);
+            val |= static_cast<size_t>(byte & 0x7f) << (7 * i);
+            if (0 == (byte & 0x80)) {
+                header_len = i + 1;
+                payload_len = val;
+                trailer_len = 0;
+                return status::ok;
+            }
+        }
+        return status::invalid;
+    }
+};
+
+template<uint8_t Byte>
+struct delimiter_end {
+    static const bool delimited = true;
+
+    static status parse(const char* data, size_t avail, size_t checksum_len,
+            size_t& header_len, size_t& payload_len, size_t& trailer_len) {
+        auto end = static_cast<const char*>(std::memchr(data, Byte, avail));
+        if (nullptr == end) {
+            return status::need_more;
+        }
+        size_t len = static_cast<size_t>(end - data);
+        if (len < checksum_len) {
+            return status::invalid;
+        }
+        header_len = 0;
+        payload_len = len - checksum_len;
+        trailer_len = 1;
+        return status::ok;
+    }
+};
+
+// checksum policies
+
+struct no_checksum {
+    static const size_t size = 0;
+
+    static bool verify(const char*, size_t, const char*) {
+        return true;
+    }
+};
+
+struct xor8 {
+    static const size_t size = 1;
+
+    static bool verify(const char* data, size_t len, const char* sum) {
+        uint8_t res = 0;
+        for (size_t i = 0; i < len; i++) {
+            res ^= static_cast<uint8_t>(data[i]);
+        }
+        return res == static_cast<uint8_t>(sum[0]);
+    }
+};
+
+struct sum8 {
+    static const size_t size = 1;
+
+    static bool verify(const char* data, size_t len, const char* sum) {
+        uint8_t res = 0;
+        for (size_t i = 0; i < len; i++) {
+            res = static_cast<uint8_t>(res + static_cast<uint8_t>(data[i]));
+        }
+        return res == static_cast<uint8_t>(sum[0]);
+    }
+};
+
+// SMBus CRC-8, polynomial 0x07
+struct crc8 {
+    static const size_t size = 1;
+
+    static const std::array<uint8_t, 256>& table() {
+        static const std::array<uint8_t, 256> tb = [] {
+            std::array<uint8_t, 256> res;
+            for (size_t i = 0; i < res.size(); i++) {
+                uint8_t crc = static_cast<uint8_t>(i);
+                for (int j = 0; j < 8; j++) {
+                    crc = static_cast<uint8_t>((crc & 0x80) ? ((crc << 1) ^ 0x07) : (crc << 1));
+                }
+                res[i] = crc;
+            }
+            return res;
+        }();
+        return tb;
+    }
+
+    static bool verify(const char* data, size_t len, const char* sum) {
+        auto& tb = table();
+        uint8_t crc = 0;
+        for (size_t i = 0; i < len; i++) {
+            crc = tb[crc ^ static_cast<uint8_t>(data[i])];
+        }
+        return crc == static_cast<uint8_t>(sum[0]);
+    }
+};
+
+// CRC-16/MODBUS, reflected polynomial 0xA001, little-endian on the wire
+struct crc16_modbus {
+    static const size_t size = 2;
+
+    static const std::array<uint16_t, 256>& table() {
+        static const std::array<uint16_t, 256> tb = [] {
+            std::array<uint16_t, 256> res;
+            for (size_t i = 0; i < res.size(); i++) {
+                uint16_t crc = static_cast<uint16_t>(i);
+                for (int j = 0; j < 8; j++) {
+                    crc = static_cast<uint16_t>((crc & 1) ? ((crc >> 1) ^ 0xa001) : (crc >> 1));
+                }
+                res[i] = crc;
+            }
+            return res;
+        }();
+        return tb;
+    }
+
+    static bool verify(const char* data, size_t len, const char* sum) {
+        auto& tb = table();
+        uint16_t crc = 0xffff;
+        for (size_t i = 0; i < len; i++) {
+            crc = static_cast<uint16_t>((crc >> 8) ^ tb[(crc ^ static_cast<uint8_t>(data[i])) & 0xff]);
+        }
+        return (crc & 0xff) == static_cast<uint8_t>(sum[0]) &&
+                (crc >> 8) == static_cast<uint8_t>(sum[1]);
+    }
+};
+
+// CRC-16/XMODEM, polynomial 0x1021, big-endian on the wire
+struct crc16_ccitt {
+    static const size_t size = 2;
+
+    static const std::array<uint16_t, 256>& table() {
+        static const std::array<uint16_t, 256> tb = [] {
+            std::array<uint16_t, 256> res;
+            for (size_t i = 0; i < res.size(); i++) {
+                uint16_t crc = static_cast<uint16_t>(i << 8);
+                for (int j = 0; j < 8; j++) {
+                    crc = static_cast<uint16_t>((crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1));
+                }
+                res[i] = crc;
+            }
+            return res;
+        }();
+        return tb;
+    }
+
+    static bool verify(const char* data, size_t len, const char* sum) {
+        auto& tb = table();
+        uint16_t crc = 0;
+        for (size_t i = 0; i < len; i++) {
+            crc = static_cast<uint16_t>((crc << 8) ^ tb[((crc >> 8) ^ static_cast<uint8_t>(data[i])) & 0xff]);
+        }
+        return (crc >> 8) == static_cast<uint8_t>(sum[0]) &&
+                (crc & 0xff) == static_cast<uint8_t>(sum[1]);
+    }
+};
+
+// CRC-32 (IEEE 802.3), little-endian on the wire
+struct crc32 {
+    static const size_t size = 4;
+
+    static const std::array<uint32_t, 256>& table() {
+        static const std::array<uint32_t, 256> tb = [] {
+            std::array<uint32_t, 256> res;
+            for (size_t i = 0; i < res.size(); i++) {
+                uint32_t crc = static_cast<uint32_t>(i);
+                for (int j = 0; j < 8; j++) {
+                    crc = (crc & 1) ? ((crc >> 1) ^ 0xedb88320) : (crc >> 1);
+                }
+                res[i] = crc;
+            }
+            return res;
+        }();
+        return tb;
+    }
+
+    static bool verify(const char* data, size_t len, const char* sum) {
+        auto& tb = table();
+        uint32_t crc = 0xffffffff;
+        for (size_t i = 0; i < len; i++) {
+            crc = (crc >> 8) ^ tb[(crc ^ static_cast<uint8_t>(data[i])) & 0xff];
+        }
+        crc ^= 0xffffffff;
+        for (size_t i = 0; i < 4; i++) {
+            if (((crc >> (8 * i)) & 0xff) != static_cast<uint8_t>(sum[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * Zero-allocation frame parser specialized at compile time
+ * for the sync, length and checksum policies; works over the caller's
+ * buffer, payloads passed to the callback point into this buffer
+ */
+template<typename Sync, typename Length, typename Checksum>
+class frame_reader {
+    size_t max_frame_length;
+    uint64_t skipped = 0;
+    // rest of the oversized delimited frame is dropped up to the delimiter
+    bool discarding = false;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param max_frame_length longer frames are treated as garbage
+     */
+    explicit frame_reader(size_t max_frame_length = 4096) :
+    max_frame_length(max_frame_length) { }
+
+    /**
+     * Parses all complete frames in the specified data, frames with
+     * invalid checksums are skipped
+     *
+     * @param data input data
+     * @param len input data length
+     * @param cb callback receiving frame payload, returns false to stop parsing
+     * @return number of bytes consumed, the rest must be passed again
+     *         with more data appended
+     */
+    template<typename Callback>
+    size_t parse(const char* data, size_t len, Callback cb) {
+        size_t pos = 0;
+        while (pos < len) {
+            const char* frame = data + pos;
+            size_t avail = len - pos;
+            if (discarding) {
+                size_t header_len = 0;
+                size_t payload_len = 0;
+                size_t trailer_len = 0;
+                auto st = Length::parse(frame, avail, 0, header_len, payload_len, trailer_len);
+                if (status::ok == st) {
+                    skip(pos, payload_len + trailer_len);
+                    discarding = false;
+                } else {
+                    skip(pos, avail);
+                }
+                continue;
+            }
+            if (avail < Sync::size) {
+                break;
+            }
+            if (!Sync::matches(frame)) {
+                skip(pos, 1);
+                continue;
+            }
+            const char* body = frame + Sync::size;
+            size_t header_len = 0;
+            size_t payload_len = 0;
+            size_t trailer_len = 0;
+            auto st = Length::parse(body, avail - Sync::size, Checksum::size,
+                    header_len, payload_len, trailer_len);
+            size_t total = Sync::size + header_len + payload_len + Checksum::size + trailer_len;
+            if (status::ok == st && total > max_frame_length) {
+                // oversized frame, delimiter bounds it, otherwise resync on the next byte
+                skip(pos, Length::delimited ? total : 1);
+                continue;
+            }
+            if (status::need_more == st || (status::ok == st && avail < total)) {
+                if (avail < max_frame_length) {
+                    break;
+                }
+                // no complete frame within the limit
+                if (Length::delimited) {
+                    skip(pos, avail);
+                    discarding = true;
+                } else {
+                    skip(pos, 1);
+                }
+                continue;
+            }
+            if (status::invalid == st) {
+                skip(pos, 1);
+                continue;
+            }
+            size_t checked_len = header_len + payload_len;
+            if (!Checksum::verify(body, checked_len, body + checked_len)) {
+                // delimiter bounds the broken frame, otherwise resync on the next byte
+                skip(pos, Length::delimited ? total : 1);
+                continue;
+            }
+            pos += total;
+            if (!cb(sl::io::span<const char>(body + header_len, payload_len))) {
+                break;
+            }
+        }
+        return pos;
+    }
+
+    /**
+     * Number of bytes dropped while looking for valid frames
+     *
+     * @return number of bytes skipped
+     */
+    uint64_t bytes_skipped() const {
+        return skipped;
+    }
+
+private:
+    void skip(size_t& pos, size_t count) {
+        pos += count;
+        skipped += count;
+    }
+};
+
+} // namespace
+}
+}
+
+#endif /* WILTON_SERIAL_FRAME_READER_HPP */
+
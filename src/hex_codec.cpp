@@ -0,0 +1,194 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   hex_codec.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 04:02 PM
+ */
+
+#include "hex_codec.hpp"
+
+#include <array>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WILTON_SERIAL_HEX_SSE2
+#include <emmintrin.h>
+#endif // SSE2
+
+#include "staticlib/support.hpp"
+
+#include "wilton/support/exception.hpp"
+
+namespace wilton {
+namespace serial {
+
+namespace { // anonymous
+
+const char* hex_symbols = "0123456789abcdef";
+
+// nibble values, -1 for invalid chars
+const std::array<int8_t, 256>& nibbles_table() {
+    static const std::array<int8_t, 256> tb = [] {
+        std::array<int8_t, 256> res;
+        res.fill(-1);
+        for (int i = 0; i < 10; i++) {
+            res['0' + i] = static_cast<int8_t>(i);
+        }
+        for (int i = 0; i < 6; i++) {
+            res['a' + i] = static_cast<int8_t>(10 + i);
+            res['A' + i] = static_cast<int8_t>(10 + i);
+        }
+        return res;
+    }();
+    return tb;
+}
+
+void encode_scalar(const uint8_t* src, size_t len, char* dest) {
+    for (size_t i = 0; i < len; i++) {
+        dest[2 * i] = hex_symbols[src[i] >> 4];
+        dest[2 * i + 1] = hex_symbols[src[i] & 0x0f];
+    }
+}
+
+void decode_scalar(const char* src, size_t len, char* dest, size_t offset) {
+    auto& tb = nibbles_table();
+    for (size_t i = 0; i < len; i += 2) {
+        int hi = tb[static_cast<uint8_t>(src[i])];
+        int lo = tb[static_cast<uint8_t>(src[i + 1])];
+        if (hi < 0 || lo < 0) {
+            size_t pos = offset + i + (hi < 0 ? 0 : 1);
+            throw support::exception(TRACEMSG("Invalid hex character,"
+                    " position: [" + sl::support::to_string(pos) + "]"));
+        }
+        dest[i / 2] = static_cast<char>((hi << 4) | lo);
+    }
+}
+
+#ifdef WILTON_SERIAL_HEX_SSE2
+
+// 16 input bytes -> 32 hex chars
+size_t encode_sse2(const uint8_t* src, size_t len, char* dest) {
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i zero_char = _mm_set1_epi8('0');
+    const __m128i alpha_shift = _mm_set1_epi8('a' - '0' - 10);
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i hi = _mm_and_si128(_mm_srli_epi16(in, 4), mask);
+        __m128i lo = _mm_and_si128(in, mask);
+        __m128i first = _mm_unpacklo_epi8(hi, lo);
+        __m128i second = _mm_unpackhi_epi8(hi, lo);
+        first = _mm_add_epi8(_mm_add_epi8(first, zero_char),
+                _mm_and_si128(_mm_cmpgt_epi8(first, nine), alpha_shift));
+        second = _mm_add_epi8(_mm_add_epi8(second, zero_char),
+                _mm_and_si128(_mm_cmpgt_epi8(second, nine), alpha_shift));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + 2 * i), first);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + 2 * i + 16), second);
+    }
+    return i;
+}
+
+// nibble values of 16 chars, false if any char is not a hex digit
+bool nibbles_sse2(__m128i chars, __m128i& out) {
+    __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+    __m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+            _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+    __m128i is_alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+            _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+    if (0xffff != _mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha))) {
+        return false;
+    }
+    __m128i digits = _mm_and_si128(is_digit, _mm_sub_epi8(chars, _mm_set1_epi8('0')));
+    __m128i alphas = _mm_and_si128(is_alpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)));
+    out = _mm_or_si128(digits, alphas);
+    return true;
+}
+
+// pairs of nibbles in 16-bit lanes (high nibble first) -> bytes
+__m128i pack_nibbles_sse2(__m128i nibbles) {
+    __m128i hi = _mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00ff)), 4);
+    __m128i lo = _mm_srli_epi16(nibbles, 8);
+    return _mm_or_si128(hi, lo);
+}
+
+// 32 hex chars -> 16 bytes, stops before the block with invalid chars
+size_t decode_sse2(const char* src, size_t len, char* dest) {
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m128i first;
+        __m128i second;
+        if (!nibbles_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), first) ||
+                !nibbles_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 16)), second)) {
+            break;
+        }
+        __m128i bytes = _mm_packus_epi16(pack_nibbles_sse2(first), pack_nibbles_sse2(second));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i / 2), bytes);
+    }
+    return i;
+}
+
+#endif // WILTON_SERIAL_HEX_SSE2
+
+} // namespace
+
+std::string hex_encode(sl::io::span<const char> data) {
+    std::string res;
+    if (0 == data.size()) {
+        return res;
+    }
+    res.resize(data.size() * 2);
+    hex_encode_into(data, {std::addressof(res.front()), res.length()});
+    return res;
+}
+
+size_t hex_encode_into(sl::io::span<const char> data, sl::io::span<char> dest) {
+    if (dest.size() / 2 < data.size()) throw support::exception(TRACEMSG(
+            "Hex destination buffer is too small, data size: [" + sl::support::to_string(data.size()) + "]," +
+            " buffer size: [" + sl::support::to_string(dest.size()) + "]"));
+    auto src = reinterpret_cast<const uint8_t*>(data.data());
+    size_t done = 0;
+#ifdef WILTON_SERIAL_HEX_SSE2
+    done = encode_sse2(src, data.size(), dest.data());
+#endif // WILTON_SERIAL_HEX_SSE2
+    encode_scalar(src + done, data.size() - done, dest.data() + done * 2);
+    return data.size() * 2;
+}
+
+std::string hex_decode(sl::io::span<const char> hex) {
+    if (0 != hex.size() % 2) throw support::exception(TRACEMSG(
+            "Invalid hex string, odd length: [" + sl::support::to_string(hex.size()) + "]"));
+    std::string res;
+    if (0 == hex.size()) {
+        return res;
+    }
+    res.resize(hex.size() / 2);
+    char* dest = std::addressof(res.front());
+    size_t done = 0;
+#ifdef WILTON_SERIAL_HEX_SSE2
+    done = decode_sse2(hex.data(), hex.size(), dest);
+#endif // WILTON_SERIAL_HEX_SSE2
+    // tail, also reports the position of invalid char
+    decode_scalar(hex.data() + done, hex.size() - done, dest + done / 2, done);
+    return res;
+}
+
+} // namespace
+}
+
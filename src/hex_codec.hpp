@@ -0,0 +1,65 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   hex_codec.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 04:00 PM
+ */
+
+#ifndef WILTON_SERIAL_HEX_CODEC_HPP
+#define WILTON_SERIAL_HEX_CODEC_HPP
+
+#include <string>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+
+namespace wilton {
+namespace serial {
+
+/**
+ * Encodes the data as lowercase hex, vectorized on x86
+ *
+ * @param data data to encode
+ * @return hex string
+ */
+std::string hex_encode(sl::io::span<const char> data);
+
+/**
+ * Encodes the data as lowercase hex into the specified buffer
+ *
+ * @param data data to encode
+ * @param dest destination buffer, must be at least twice as large as the data
+ * @return number of hex chars written
+ */
+size_t hex_encode_into(sl::io::span<const char> data, sl::io::span<char> dest);
+
+/**
+ * Decodes hex string (any case), vectorized on x86
+ *
+ * @param hex hex string
+ * @return decoded data
+ * @throws support::exception on odd length or invalid characters
+ */
+std::string hex_decode(sl::io::span<const char> hex);
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_HEX_CODEC_HPP */
+
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   line_reader.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 01:32 PM
+ */
+
+#include "line_reader.hpp"
+
+#include <array>
+#include <cstring>
+
+#include "staticlib/utils.hpp"
+
+namespace wilton {
+namespace serial {
+
+namespace { // anonymous
+
+// lines without terminator are returned as is after this length
+const size_t max_line_length = 1 << 16;
+
+void push_line(std::vector<std::string>& res, std::string& line) {
+    if (line.length() > 0 && '\r' == line.back()) {
+        line.pop_back();
+    }
+    res.emplace_back(std::move(line));
+    line = std::string();
+}
+
+} // namespace
+
+std::vector<std::string> read_lines(connection& conn, uint32_t max_lines, uint32_t timeout_millis) {
+    uint32_t timeout = timeout_millis > 0 ? timeout_millis : conn.config().timeout_millis;
+    uint64_t start = sl::utils::current_time_millis_steady();
+    uint64_t finish = start + timeout;
+    std::vector<std::string> res;
+    std::string partial;
+    std::array<char, 1024> buf;
+    while (res.size() < max_lines) {
+        uint64_t cur = sl::utils::current_time_millis_steady();
+        // after the first line only the data already received is consumed
+        uint32_t wait = (res.empty() && cur < finish) ? static_cast<uint32_t>(finish - cur) : 0;
+        uint32_t read = conn.read_available({buf.data(), buf.size()}, wait);
+        if (0 == read) {
+            if (!res.empty() || sl::utils::current_time_millis_steady() >= finish) {
+                break;
+            }
+            continue;
+        }
+        const char* begin = buf.data();
+        const char* end = buf.data() + read;
+        while (begin < end) {
+            auto nl = static_cast<const char*>(std::memchr(begin, '\n', static_cast<size_t>(end - begin)));
+            if (nullptr == nl) {
+                partial.append(begin, static_cast<size_t>(end - begin));
+                if (partial.length() >= max_line_length) {
+                    push_line(res, partial);
+                }
+                break;
+            }
+            partial.append(begin, static_cast<size_t>(nl - begin));
+            push_line(res, partial);
+            begin = nl + 1;
+            if (res.size() >= max_lines) {
+                if (begin < end) {
+                    conn.unread({begin, static_cast<size_t>(end - begin)});
+                }
+                break;
+            }
+        }
+    }
+    if (partial.length() > 0) {
+        conn.unread({partial.data(), partial.length()});
+    }
+    return res;
+}
+
+} // namespace
+}
+
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   line_reader.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 01:30 PM
+ */
+
+#ifndef WILTON_SERIAL_LINE_READER_HPP
+#define WILTON_SERIAL_LINE_READER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "staticlib/config.hpp"
+
+#include "connection.hpp"
+
+namespace wilton {
+namespace serial {
+
+/**
+ * Reads complete lines from the connection, waits until at least one line
+ * is received or the timeout expires, then returns all the lines that are
+ * already available without waiting for more; line terminators (LF or CRLF)
+ * are removed, incomplete trailing line is returned back to the connection
+ *
+ * @param conn connection
+ * @param max_lines max number of lines to return
+ * @param timeout_millis max time to wait for the first line, connection timeout is used if zero
+ * @return lines read, empty if no complete line was received before the timeout
+ */
+std::vector<std::string> read_lines(connection& conn, uint32_t max_lines, uint32_t timeout_millis);
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_LINE_READER_HPP */
+
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   line_settings.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 10:15 PM
+ */
+
+#ifndef WILTON_SERIAL_LINE_SETTINGS_HPP
+#define WILTON_SERIAL_LINE_SETTINGS_HPP
+
+#include <cstdint>
+
+namespace wilton {
+namespace serial {
+
+class serial_config;
+
+/**
+ * Line parameters derived from the config once, then applied
+ * to the port on every open (and reopen) without revalidation
+ */
+class line_settings {
+public:
+    // termios flags, applied as '(current & keep) | set'
+    uint32_t iflag_keep = 0;
+    uint32_t iflag_set = 0;
+    uint32_t oflag_keep = 0;
+    uint32_t oflag_set = 0;
+    uint32_t cflag_keep = 0;
+    uint32_t cflag_set = 0;
+    uint32_t lflag_keep = 0;
+    uint32_t lflag_set = 0;
+    uint8_t vmin = 0;
+    uint8_t vtime = 0;
+    // speed_t constant on termios, DCB 'BaudRate' on Windows
+    uint32_t speed = 0;
+    // DCB fields, Windows only
+    uint8_t byte_size = 0;
+    uint8_t stop_bits = 0;
+    uint8_t parity = 0;
+    bool parity_check = false;
+};
+
+/**
+ * Validates line parameters and converts them to the platform representation,
+ * implemented in the platform-specific connection source
+ *
+ * @param conf connection config
+ * @return compiled settings
+ */
+line_settings compile_line_settings(const serial_config& conf);
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_LINE_SETTINGS_HPP */
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   modem_line.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 08:40 PM
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "staticlib/support.hpp"
+
+#include "wilton/support/exception.hpp"
+
+#ifndef WILTON_SERIAL_MODEM_LINE_HPP
+#define WILTON_SERIAL_MODEM_LINE_HPP
+
+namespace wilton {
+namespace serial {
+
+enum class modem_line {
+    dtr,
+    rts,
+    cts,
+    dsr,
+    dcd,
+    ri
+};
+
+inline std::string stringify_modem_line(modem_line ml) {
+    switch (ml) {
+    case modem_line::dtr: return "DTR";
+    case modem_line::rts: return "RTS";
+    case modem_line::cts: return "CTS";
+    case modem_line::dsr: return "DSR";
+    case modem_line::dcd: return "DCD";
+    case modem_line::ri: return "RI";
+    default: return "UNKNOWN";
+    }
+}
+
+inline modem_line make_modem_line(const std::string& st) {
+    if ("DTR" == st) {
+        return modem_line::dtr;
+    } else if ("RTS" == st) {
+        return modem_line::rts;
+    } else if ("CTS" == st) {
+        return modem_line::cts;
+    } else if ("DSR" == st) {
+        return modem_line::dsr;
+    } else if ("DCD" == st) {
+        return modem_line::dcd;
+    } else if ("RI" == st) {
+        return modem_line::ri;
+    } else throw support::exception(TRACEMSG("Invalid modem line: [" + st + "]"));
+}
+
+/**
+ * Lines driven by the remote side, changes of these lines can be waited for
+ *
+ * @param ml modem line
+ * @return true for CTS, DSR, DCD and RI
+ */
+inline bool is_input_modem_line(modem_line ml) {
+    return modem_line::dtr != ml && modem_line::rts != ml;
+}
+
+/**
+ * Parses comma-separated list of line names, e.g. "DSR,CTS"
+ *
+ * @param st list of names
+ * @return modem lines
+ */
+inline std::vector<modem_line> make_modem_lines(const std::string& st) {
+    auto res = std::vector<modem_line>();
+    size_t start = 0;
+    for (;;) {
+        auto comma = st.find(',', start);
+        auto name = st.substr(start, std::string::npos != comma ? comma - start : std::string::npos);
+        res.push_back(make_modem_line(name));
+        if (std::string::npos == comma) {
+            break;
+        }
+        start = comma + 1;
+    }
+    return res;
+}
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_MODEM_LINE_HPP */
@@ -0,0 +1,201 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   modem_monitor.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 09:02 PM
+ */
+
+#include "modem_monitor.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#include <sys/ioctl.h>
+#include <termios.h>
+
+#include <pthread.h>
+
+#ifdef __linux__
+#include <linux/serial.h>
+#endif // __linux__
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "wilton/support/exception.hpp"
+
+namespace wilton {
+namespace serial {
+
+namespace { // anonymous
+
+const std::array<int, 4> input_bits = {{ TIOCM_CTS, TIOCM_DSR, TIOCM_CD, TIOCM_RNG }};
+
+size_t input_index(modem_line ml) {
+    switch (ml) {
+    case modem_line::cts: return 0;
+    case modem_line::dsr: return 1;
+    case modem_line::dcd: return 2;
+    case modem_line::ri: return 3;
+    default: throw support::exception(TRACEMSG(
+            "Output modem line cannot be waited for: [" + stringify_modem_line(ml) + "]"));
+    }
+}
+
+bool read_counters(int fd, std::array<uint64_t, 4>& counts) {
+#ifdef TIOCGICOUNT
+    struct serial_icounter_struct ic;
+    std::memset(std::addressof(ic), '\0', sizeof(ic));
+    if (0 != ::ioctl(fd, TIOCGICOUNT, std::addressof(ic))) {
+        return false;
+    }
+    counts[0] = static_cast<uint64_t>(ic.cts);
+    counts[1] = static_cast<uint64_t>(ic.dsr);
+    counts[2] = static_cast<uint64_t>(ic.dcd);
+    counts[3] = static_cast<uint64_t>(ic.rng);
+    return true;
+#else // !TIOCGICOUNT
+    (void) fd;
+    (void) counts;
+    return false;
+#endif // TIOCGICOUNT
+}
+
+int read_lines_state(int fd) {
+    int status = 0;
+    if (0 != ::ioctl(fd, TIOCMGET, std::addressof(status))) throw support::exception(TRACEMSG(
+            "Serial 'TIOCMGET' error: [" + ::strerror(errno) + "]"));
+    return status;
+}
+
+} // namespace
+
+modem_monitor::modem_monitor(int fd, const std::vector<modem_line>& lines) {
+    for (modem_line ml : lines) {
+        idxs.push_back(input_index(ml));
+    }
+    initial.fill(0);
+    this->counters_supported = read_counters(fd, initial);
+    if (!counters_supported) {
+        this->lines_state = read_lines_state(fd);
+    }
+    this->counts = initial;
+}
+
+bool modem_monitor::poll(int fd) {
+    if (counters_supported) {
+        if (!read_counters(fd, counts)) throw support::exception(TRACEMSG(
+                "Serial 'TIOCGICOUNT' error: [" + ::strerror(errno) + "]"));
+    } else {
+        int cur = read_lines_state(fd);
+        for (size_t i = 0; i < input_bits.size(); i++) {
+            if ((lines_state & input_bits[i]) != (cur & input_bits[i])) {
+                counts[i] += 1;
+            }
+        }
+        this->lines_state = cur;
+    }
+    for (size_t idx : idxs) {
+        if (counts[idx] != initial[idx]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void modem_monitor::check_lines(const std::vector<modem_line>& lines) {
+    for (modem_line ml : lines) {
+        input_index(ml);
+    }
+}
+
+modem_waiter::modem_waiter(int fd) :
+fd(fd) {
+    this->worker = std::thread([this] {
+        this->run();
+    });
+}
+
+modem_waiter::~modem_waiter() STATICLIB_NOEXCEPT {
+    stop();
+}
+
+void modem_waiter::stop() STATICLIB_NOEXCEPT {
+    if (!worker.joinable()) {
+        return;
+    }
+    // no-op if the helper has already finished on error
+    ::pthread_cancel(worker.native_handle());
+    worker.join();
+    std::lock_guard<std::mutex> guard{mutex};
+    this->running = false;
+    cv.notify_all();
+}
+
+uint64_t modem_waiter::events_count() {
+    std::lock_guard<std::mutex> guard{mutex};
+    return events;
+}
+
+bool modem_waiter::wait_event(uint64_t seen, uint64_t finish) {
+    std::unique_lock<std::mutex> guard{mutex};
+    for (;;) {
+        if (!running) {
+            return false;
+        }
+        uint64_t cur = sl::utils::current_time_millis_steady();
+        if (events != seen || cur >= finish) {
+            return true;
+        }
+        cv.wait_for(guard, std::chrono::milliseconds(finish - cur));
+    }
+}
+
+void modem_waiter::run() {
+#ifdef TIOCMIWAIT
+    int mask = TIOCM_CTS | TIOCM_DSR | TIOCM_CD | TIOCM_RNG;
+    for (;;) {
+        // TIOCMIWAIT is not a cancellation point, the mutex is never held here
+        int oldtype = 0;
+        ::pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, std::addressof(oldtype));
+        int res = ::ioctl(fd, TIOCMIWAIT, mask);
+        int err = errno;
+        ::pthread_setcanceltype(PTHREAD_CANCEL_DEFERRED, std::addressof(oldtype));
+        std::lock_guard<std::mutex> guard{mutex};
+        if (0 == res) {
+            this->events += 1;
+        } else if (EINTR != err) {
+            // ENOTTY or EINVAL when not supported, EIO on hangup
+            this->running = false;
+        }
+        cv.notify_all();
+        if (!running) {
+            return;
+        }
+    }
+#else // !TIOCMIWAIT
+    std::lock_guard<std::mutex> guard{mutex};
+    this->running = false;
+    cv.notify_all();
+#endif // TIOCMIWAIT
+}
+
+} // namespace
+}
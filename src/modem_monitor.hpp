@@ -0,0 +1,160 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   modem_monitor.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 08:55 PM
+ */
+
+#ifndef WILTON_SERIAL_MODEM_MONITOR_HPP
+#define WILTON_SERIAL_MODEM_MONITOR_HPP
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config.hpp"
+
+#include "modem_line.hpp"
+
+namespace wilton {
+namespace serial {
+
+/**
+ * Tracks the changes of the input modem lines (CTS, DSR, DCD, RI)
+ * for a single wait, lines are polled by the waiting caller
+ *
+ * On Linux the kernel transition counters (TIOCGICOUNT) are polled,
+ * so the changes between the polls are not missed. Where the counters
+ * are not supported by the driver, line states are polled with TIOCMGET
+ * and the pulses shorter than the poll interval can be missed.
+ *
+ * Descriptor is not stored, it is passed to each call, so the caller
+ * can re-read it under the connection lock. Between the polls the caller
+ * either sleeps or, where supported, waits for the 'modem_waiter' wakeup.
+ */
+class modem_monitor {
+    std::vector<size_t> idxs;
+    bool counters_supported = false;
+    // transitions count for CTS, DSR, DCD and RI
+    std::array<uint64_t, 4> initial;
+    std::array<uint64_t, 4> counts;
+    int lines_state = 0;
+
+public:
+    /**
+     * Constructor, takes the initial lines state
+     *
+     * @param fd port descriptor
+     * @param lines input lines to watch
+     */
+    modem_monitor(int fd, const std::vector<modem_line>& lines);
+
+    modem_monitor(const modem_monitor&) = delete;
+
+    modem_monitor& operator=(const modem_monitor&) = delete;
+
+    /**
+     * Reads the current lines state
+     *
+     * @param fd port descriptor, must refer to the same open port as on construction
+     * @return true if any of the watched lines changed since construction
+     */
+    bool poll(int fd);
+
+    /**
+     * Throws if any of the specified lines is not an input line
+     *
+     * @param lines lines to check
+     */
+    static void check_lines(const std::vector<modem_line>& lines);
+};
+
+/**
+ * Blocks in TIOCMIWAIT in a helper thread and wakes up the waiting callers
+ * on each change of the input lines, the lines themselves are still compared
+ * by the 'modem_monitor' under the connection lock.
+ *
+ * TIOCMIWAIT cannot be bounded by the timeout and is not woken by 'close',
+ * so the helper thread is cancelled (async cancellation is enabled only
+ * around the ioctl) and joined in 'stop', that must be called before
+ * the descriptor is closed. Helper thread never takes the connection lock.
+ *
+ * When the driver (or the platform) does not support TIOCMIWAIT, or the port
+ * is hung up, the helper finishes and the callers fall back to the polling.
+ */
+class modem_waiter {
+    int fd;
+    std::mutex mutex;
+    std::condition_variable cv;
+    // incremented on each lines change reported by the driver
+    uint64_t events = 0;
+    bool running = true;
+    std::thread worker;
+
+public:
+    /**
+     * Constructor, starts the helper thread
+     *
+     * @param fd port descriptor, must stay open until 'stop' is called
+     */
+    modem_waiter(int fd);
+
+    modem_waiter(const modem_waiter&) = delete;
+
+    modem_waiter& operator=(const modem_waiter&) = delete;
+
+    /**
+     * Destructor, stops the helper thread
+     */
+    ~modem_waiter() STATICLIB_NOEXCEPT;
+
+    /**
+     * Stops the helper thread and wakes up all the waiting callers
+     */
+    void stop() STATICLIB_NOEXCEPT;
+
+    /**
+     * Returns the number of changes reported so far, must be taken
+     * before the lines are polled
+     *
+     * @return events count
+     */
+    uint64_t events_count();
+
+    /**
+     * Waits until the events count differs from the specified one
+     *
+     * @param seen events count taken before the last poll
+     * @param finish deadline, steady clock millis
+     * @return false if the helper is not running and the caller must poll instead
+     */
+    bool wait_event(uint64_t seen, uint64_t finish);
+
+private:
+    // must not be noexcept, cancellation unwinds the stack
+    void run();
+};
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_MODEM_MONITOR_HPP */
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   nmea.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 01:42 PM
+ */
+
+#include "nmea.hpp"
+
+#include <string>
+
+#include "line_reader.hpp"
+
+namespace wilton {
+namespace serial {
+
+namespace { // anonymous
+
+int hex_digit(char ch) {
+    if (ch >= '0' && ch <= '9') {
+        return ch - '0';
+    } else if (ch >= 'A' && ch <= 'F') {
+        return ch - 'A' + 10;
+    } else if (ch >= 'a' && ch <= 'f') {
+        return ch - 'a' + 10;
+    }
+    return -1;
+}
+
+} // namespace
+
+bool parse_nmea_sentence(sl::io::span<const char> line, std::vector<sl::io::span<const char>>& fields) {
+    fields.clear();
+    const char* data = line.data();
+    size_t len = line.size();
+    if (len < 4 || ('$' != data[0] && '!' != data[0])) {
+        return false;
+    }
+    // checksum covers everything between the start char and '*'
+    uint8_t sum = 0;
+    size_t field_start = 1;
+    size_t i = 1;
+    for (; i < len && '*' != data[i]; i++) {
+        sum ^= static_cast<uint8_t>(data[i]);
+        if (',' == data[i]) {
+            fields.emplace_back(data + field_start, i - field_start);
+            field_start = i + 1;
+        }
+    }
+    fields.emplace_back(data + field_start, i - field_start);
+    if (i + 3 != len) {
+        return false;
+    }
+    int hi = hex_digit(data[i + 1]);
+    int lo = hex_digit(data[i + 2]);
+    if (hi < 0 || lo < 0) {
+        return false;
+    }
+    return sum == static_cast<uint8_t>((hi << 4) | lo);
+}
+
+sl::json::value read_nmea(connection& conn, uint32_t max_sentences, uint32_t timeout_millis) {
+    auto lines = read_lines(conn, max_sentences, timeout_millis);
+    auto sentences = std::vector<sl::json::value>();
+    sentences.reserve(lines.size());
+    uint32_t invalid_count = 0;
+    auto fields = std::vector<sl::io::span<const char>>();
+    for (auto& li : lines) {
+        if (li.empty()) {
+            continue;
+        }
+        if (!parse_nmea_sentence({li.data(), li.length()}, fields)) {
+            invalid_count += 1;
+            continue;
+        }
+        auto arr = std::vector<sl::json::value>();
+        arr.reserve(fields.size());
+        for (auto& fi : fields) {
+            arr.emplace_back(std::string(fi.data(), fi.size()));
+        }
+        sentences.emplace_back(std::move(arr));
+    }
+    auto res = std::vector<sl::json::field>();
+    res.emplace_back("sentences", std::move(sentences));
+    res.emplace_back("invalidCount", invalid_count);
+    return sl::json::value(std::move(res));
+}
+
+} // namespace
+}
+
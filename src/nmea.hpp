@@ -0,0 +1,65 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   nmea.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 01:40 PM
+ */
+
+#ifndef WILTON_SERIAL_NMEA_HPP
+#define WILTON_SERIAL_NMEA_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+#include "staticlib/json.hpp"
+
+#include "connection.hpp"
+
+namespace wilton {
+namespace serial {
+
+/**
+ * Splits NMEA 0183 sentence into the address and data fields and validates
+ * its checksum, fields point into the line data, the vector is cleared
+ * and reused by the caller
+ *
+ * @param line sentence starting with '$' or '!', without line terminator
+ * @param fields output fields, first one is the address ("GPGGA")
+ * @return true if the sentence is well-formed and checksum matches
+ */
+bool parse_nmea_sentence(sl::io::span<const char> line, std::vector<sl::io::span<const char>>& fields);
+
+/**
+ * Reads a batch of NMEA sentences from the connection, sentences with
+ * invalid checksums are skipped and counted
+ *
+ * @param conn connection
+ * @param max_sentences max number of lines to read
+ * @param timeout_millis max time to wait for the first sentence, connection timeout is used if zero
+ * @return object with "sentences" (array of arrays of fields) and "invalidCount"
+ */
+sl::json::value read_nmea(connection& conn, uint32_t max_sentences, uint32_t timeout_millis);
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_NMEA_HPP */
+
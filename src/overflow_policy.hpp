@@ -0,0 +1,63 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   overflow_policy.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 04:30 PM
+ */
+
+#include <string>
+
+#include "staticlib/support.hpp"
+
+#include "wilton/support/exception.hpp"
+
+#ifndef WILTON_SERIAL_OVERFLOW_POLICY_HPP
+#define WILTON_SERIAL_OVERFLOW_POLICY_HPP
+
+namespace wilton {
+namespace serial {
+
+enum class overflow_policy {
+    // lagging subscriber loses the oldest data
+    drop_oldest,
+    // port is not read until the lagging subscriber consumes its data
+    block
+};
+
+inline std::string stringify_overflow_policy(overflow_policy op) {
+    switch (op) {
+    case overflow_policy::drop_oldest: return "DROP_OLDEST";
+    case overflow_policy::block: return "BLOCK";
+    default: return "UNKNOWN";
+    }
+}
+
+inline overflow_policy make_overflow_policy(const std::string& st) {
+    if ("DROP_OLDEST" == st) {
+        return overflow_policy::drop_oldest;
+    } else if ("BLOCK" == st) {
+        return overflow_policy::block;
+    } else throw support::exception(TRACEMSG("Invalid overflow policy: [" + st + "]"));
+}
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_OVERFLOW_POLICY_HPP */
+
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   pattern_watcher.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 07:24 PM
+ */
+
+#include "pattern_watcher.hpp"
+
+#include <algorithm>
+#include <array>
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "wilton/support/exception.hpp"
+
+#include "hex_codec.hpp"
+
+namespace wilton {
+namespace serial {
+
+namespace { // anonymous
+
+std::vector<std::string> patterns_from_json(const sl::json::value& conf) {
+    auto res = std::vector<std::string>();
+    for (const sl::json::field& fi : conf.as_object_or_throw("pattern_watcher")) {
+        if ("patternsHex" == fi.name()) {
+            for (const sl::json::value& va : fi.as_array_or_throw(fi.name())) {
+                res.emplace_back(hex_decode(va.as_string_nonempty_or_throw("patternsHex")));
+            }
+        }
+    }
+    if (res.empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'patternsHex' not specified"));
+    return res;
+}
+
+} // namespace
+
+pattern_watcher::pattern_watcher(connection& conn, const sl::json::value& conf) :
+conn(conn),
+matcher(patterns_from_json(conf)),
+context_before(0),
+context_after(0),
+queue_size(64) {
+    for (const sl::json::field& fi : conf.as_object()) {
+        auto& name = fi.name();
+        if ("patternsHex" == name) {
+            // parsed above
+        } else if ("contextBefore" == name) {
+            this->context_before = fi.as_uint32_or_throw(name);
+        } else if ("contextAfter" == name) {
+            this->context_after = fi.as_uint32_or_throw(name);
+        } else if ("queueSize" == name) {
+            this->queue_size = fi.as_uint32_positive_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown pattern watcher field: [" + name + "]"));
+        }
+    }
+}
+
+sl::json::value pattern_watcher::wait(uint32_t max_matches, uint32_t timeout_millis) {
+    uint32_t timeout = timeout_millis > 0 ? timeout_millis : conn.config().timeout_millis;
+    uint64_t finish = sl::utils::current_time_millis_steady() + timeout;
+    std::array<char, 1024> buf;
+    while (ready.empty()) {
+        uint64_t cur = sl::utils::current_time_millis_steady();
+        if (cur >= finish) {
+            // deliver what is known, after-context is not coming in time
+            while (!pending.empty()) {
+                enqueue(std::move(pending.front()));
+                pending.pop_front();
+            }
+            break;
+        }
+        uint32_t read = conn.read_available({buf.data(), buf.size()}, static_cast<uint32_t>(finish - cur));
+        if (read > 0) {
+            feed({buf.data(), read});
+        }
+    }
+    auto matches = std::vector<sl::json::value>();
+    while (!ready.empty() && matches.size() < max_matches) {
+        auto& ma = ready.front();
+        matches.emplace_back(sl::json::value({
+            { "patternIndex", ma.pattern_idx },
+            { "offset", ma.offset },
+            { "contextHex", hex_encode(ma.context) }
+        }));
+        ready.pop_front();
+    }
+    auto fields = std::vector<sl::json::field>();
+    fields.emplace_back("matches", std::move(matches));
+    fields.emplace_back("droppedCount", dropped_count);
+    return sl::json::value(std::move(fields));
+}
+
+void pattern_watcher::feed(sl::io::span<const char> data) {
+    history.append(data.data(), data.size());
+    // stream offset of the first history byte
+    uint64_t base = stream_offset + data.size() - history.length();
+    uint64_t avail_end = base + history.length();
+    auto take_after = [this, base, avail_end](match& ma) {
+        if (ma.after_needed > 0 && ma.next_offset < avail_end) {
+            auto len = static_cast<uint32_t>(std::min(static_cast<uint64_t>(ma.after_needed),
+                    avail_end - ma.next_offset));
+            ma.context.append(history, static_cast<size_t>(ma.next_offset - base), len);
+            ma.next_offset += len;
+            ma.after_needed -= len;
+        }
+    };
+    for (auto& ma : pending) {
+        take_after(ma);
+    }
+    matcher.feed(data, [&](uint32_t idx, size_t end_in_chunk) {
+        uint64_t end = stream_offset + end_in_chunk;
+        uint64_t start = end - matcher.pattern_length(idx);
+        uint64_t ctx_start = start > base + context_before ? start - context_before : base;
+        auto ctx = history.substr(static_cast<size_t>(ctx_start - base), static_cast<size_t>(end - ctx_start));
+        pending.emplace_back(idx, start, std::move(ctx), end, context_after);
+        take_after(pending.back());
+    });
+    stream_offset += data.size();
+    // matches complete in stream order
+    while (!pending.empty() && (0 == pending.front().after_needed || pending.size() > queue_size)) {
+        enqueue(std::move(pending.front()));
+        pending.pop_front();
+    }
+    size_t keep = matcher.max_pattern_length() + context_before;
+    if (history.length() > keep) {
+        history.erase(0, history.length() - keep);
+    }
+}
+
+void pattern_watcher::enqueue(match&& ma) {
+    ready.emplace_back(std::move(ma));
+    if (ready.size() > queue_size) {
+        ready.pop_front();
+        dropped_count += 1;
+    }
+}
+
+} // namespace
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   pattern_watcher.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 07:20 PM
+ */
+
+#ifndef WILTON_SERIAL_PATTERN_WATCHER_HPP
+#define WILTON_SERIAL_PATTERN_WATCHER_HPP
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+#include "staticlib/json.hpp"
+
+#include "aho_corasick.hpp"
+#include "connection.hpp"
+
+namespace wilton {
+namespace serial {
+
+/**
+ * Runs the multi-pattern matcher over the received data and
+ * queues only the matches along with the surrounding bytes;
+ * the port is read by the waiting caller, there is no extra thread
+ *
+ * Connection must not be read directly while the watcher is active,
+ * such reads must be rejected by the caller.
+ */
+class pattern_watcher {
+    class match {
+    public:
+        uint32_t pattern_idx;
+        // stream offset of the match start
+        uint64_t offset;
+        std::string context;
+        // stream offset of the next after-context byte
+        uint64_t next_offset;
+        uint32_t after_needed;
+
+        match(uint32_t pattern_idx, uint64_t offset, std::string&& context,
+                uint64_t next_offset, uint32_t after_needed) :
+        pattern_idx(pattern_idx),
+        offset(offset),
+        context(std::move(context)),
+        next_offset(next_offset),
+        after_needed(after_needed) { }
+    };
+
+    connection& conn;
+    aho_corasick matcher;
+    uint32_t context_before;
+    uint32_t context_after;
+    uint32_t queue_size;
+    // tail of the stream, enough to cut the context before the longest match
+    std::string history;
+    // total number of bytes matched
+    uint64_t stream_offset = 0;
+    std::deque<match> pending;
+    std::deque<match> ready;
+    uint64_t dropped_count = 0;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param conn connection, must outlive the watcher
+     * @param conf JSON with "patternsHex", "contextBefore", "contextAfter" and "queueSize"
+     */
+    pattern_watcher(connection& conn, const sl::json::value& conf);
+
+    pattern_watcher(const pattern_watcher&) = delete;
+
+    pattern_watcher& operator=(const pattern_watcher&) = delete;
+
+    /**
+     * Reads the port until at least one match is available or the timeout expires,
+     * matches with incomplete after-context are returned on timeout
+     *
+     * @param max_matches max number of matches to return
+     * @param timeout_millis max time to wait for the first match
+     * @return object with "matches" (list of "patternIndex", "offset", "contextHex")
+     *         and "droppedCount"
+     */
+    sl::json::value wait(uint32_t max_matches, uint32_t timeout_millis);
+
+private:
+    void feed(sl::io::span<const char> data);
+
+    void enqueue(match&& ma);
+};
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_PATTERN_WATCHER_HPP */
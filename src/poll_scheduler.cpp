@@ -0,0 +1,261 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   poll_scheduler.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 06:24 PM
+ */
+
+#include "poll_scheduler.hpp"
+
+#include <algorithm>
+#include <array>
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "wilton/support/exception.hpp"
+
+#include "hex_codec.hpp"
+#include "tx_timing.hpp"
+
+namespace wilton {
+namespace serial {
+
+namespace { // anonymous
+
+// bounds the discarding for the device that sends continuously
+const size_t discard_max_reads = 64;
+
+uint64_t wall_clock_millis() {
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+}
+
+} // namespace
+
+poll_scheduler::entry::entry(const sl::json::value& json) :
+period(0),
+timeout(0) {
+    uint32_t max_frame_length = 4096;
+    for (const sl::json::field& fi : json.as_object_or_throw("entries")) {
+        auto& name = fi.name();
+        if ("requestHex" == name) {
+            this->request = hex_decode(fi.as_string_nonempty_or_throw(name));
+        } else if ("periodMillis" == name) {
+            this->period = std::chrono::milliseconds(fi.as_uint32_positive_or_throw(name));
+        } else if ("timeoutMillis" == name) {
+            this->timeout = std::chrono::milliseconds(fi.as_uint32_positive_or_throw(name));
+        } else if ("framing" == name) {
+            this->framing = fi.as_string_nonempty_or_throw(name);
+        } else if ("maxFrameLength" == name) {
+            max_frame_length = fi.as_uint32_positive_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown poll entry field: [" + name + "]"));
+        }
+    }
+    if (request.empty()) throw support::exception(TRACEMSG(
+            "Required poll entry field 'requestHex' not specified"));
+    if (0 == period.count()) throw support::exception(TRACEMSG(
+            "Required poll entry field 'periodMillis' not specified"));
+    if (framing.empty()) throw support::exception(TRACEMSG(
+            "Required poll entry field 'framing' not specified"));
+    if (0 == timeout.count() || timeout > period) {
+        this->timeout = period;
+    }
+    this->parser = make_frame_parser(framing, max_frame_length);
+}
+
+poll_scheduler::poll_scheduler(connection& conn, std::mutex& io_mutex, const sl::json::value& conf) :
+conn(conn),
+io_mutex(io_mutex),
+history_size(16) {
+    for (const sl::json::field& fi : conf.as_object_or_throw("poll_scheduler")) {
+        auto& name = fi.name();
+        if ("entries" == name) {
+            for (const sl::json::value& va : fi.as_array_or_throw(name)) {
+                entries.emplace_back(va);
+            }
+        } else if ("historySize" == name) {
+            this->history_size = fi.as_uint32_positive_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown poll scheduler field: [" + name + "]"));
+        }
+    }
+    if (entries.empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'entries' not specified"));
+    auto now = std::chrono::steady_clock::now();
+    for (auto& en : entries) {
+        en.next_due = now;
+    }
+    poller = std::thread([this] {
+        run();
+    });
+}
+
+poll_scheduler::~poll_scheduler() STATICLIB_NOEXCEPT {
+    {
+        std::lock_guard<std::mutex> guard{mutex};
+        stopping = true;
+    }
+    cv.notify_one();
+    poller.join();
+}
+
+sl::json::value poll_scheduler::results() {
+    std::lock_guard<std::mutex> guard{mutex};
+    if (!bg_error.empty()) {
+        auto err = std::move(bg_error);
+        bg_error = std::string();
+        throw support::exception(TRACEMSG(err));
+    }
+    auto res = std::vector<sl::json::value>();
+    for (auto& en : entries) {
+        auto history = std::vector<sl::json::value>();
+        for (auto& re : en.history) {
+            history.emplace_back(sl::json::value({
+                { "timestampMillis", re.timestamp_millis },
+                { "latencyMicros", re.latency_micros },
+                { "dataHex", hex_encode(re.data) },
+                { "timedOut", re.timed_out }
+            }));
+        }
+        auto fields = std::vector<sl::json::field>();
+        fields.emplace_back("requestHex", hex_encode(en.request));
+        fields.emplace_back("pollsCount", en.polls_count);
+        fields.emplace_back("timeoutsCount", en.timeouts_count);
+        fields.emplace_back("missedSlotsCount", en.missed_slots_count);
+        fields.emplace_back("bytesSkipped", en.bytes_skipped);
+        fields.emplace_back("staleBytesCount", en.stale_bytes_count);
+        fields.emplace_back("history", std::move(history));
+        res.emplace_back(std::move(fields));
+    }
+    return sl::json::value(std::move(res));
+}
+
+void poll_scheduler::run() STATICLIB_NOEXCEPT {
+    const auto spin = std::chrono::microseconds(200);
+    std::unique_lock<std::mutex> guard{mutex};
+    while (!stopping) {
+        auto it = std::min_element(entries.begin(), entries.end(), [](const entry& a, const entry& b) {
+            return a.next_due < b.next_due;
+        });
+        entry& en = *it;
+        // coarse wait is interruptible, the last part is precise
+        auto stopped = cv.wait_until(guard, en.next_due - spin, [this] {
+            return stopping;
+        });
+        if (stopped) {
+            break;
+        }
+        guard.unlock();
+        sleep_until_precise(en.next_due);
+        try {
+            poll_entry(en);
+        } catch (const std::exception& e) {
+            guard.lock();
+            bg_error = e.what();
+            schedule_next(en, std::chrono::steady_clock::now());
+            continue;
+        }
+        guard.lock();
+    }
+}
+
+void poll_scheduler::poll_entry(entry& en) {
+    std::unique_lock<std::mutex> io_guard{io_mutex};
+    // late reply to the previous request must not be taken for this one
+    uint64_t stale = discard_input();
+    auto start = std::chrono::steady_clock::now();
+    uint64_t timestamp = wall_clock_millis();
+    uint32_t written = conn.write({en.request.data(), en.request.length()});
+    if (written < en.request.length()) throw support::exception(TRACEMSG(
+            "Poll request write timeout, bytes to write: [" + sl::support::to_string(en.request.length()) + "],"
+            " bytes written: [" + sl::support::to_string(written) + "]"));
+    bool timed_out = false;
+    auto data = read_reply(en, timed_out);
+    io_guard.unlock();
+    auto finish = std::chrono::steady_clock::now();
+    auto latency = std::chrono::duration_cast<std::chrono::microseconds>(finish - start);
+    std::lock_guard<std::mutex> guard{mutex};
+    en.stale_bytes_count += stale;
+    en.polls_count += 1;
+    if (timed_out) {
+        en.timeouts_count += 1;
+    }
+    en.bytes_skipped = en.parser->bytes_skipped();
+    en.history.emplace_back(timestamp, static_cast<uint64_t>(latency.count()), std::move(data), timed_out);
+    while (en.history.size() > history_size) {
+        en.history.pop_front();
+    }
+    schedule_next(en, finish);
+}
+
+void poll_scheduler::schedule_next(entry& en, std::chrono::steady_clock::time_point now) {
+    // keep the slots grid, skip the slots that already passed
+    en.next_due += en.period;
+    if (en.next_due <= now) {
+        auto behind = (now - en.next_due) / en.period + 1;
+        en.missed_slots_count += static_cast<uint64_t>(behind);
+        en.next_due += en.period * behind;
+    }
+}
+
+uint64_t poll_scheduler::discard_input() {
+    std::array<char, 1024> buf;
+    uint64_t discarded = 0;
+    for (size_t i = 0; i < discard_max_reads; i++) {
+        uint32_t read = conn.read_available({buf.data(), buf.size()}, 0);
+        if (0 == read) {
+            break;
+        }
+        discarded += read;
+    }
+    return discarded;
+}
+
+std::string poll_scheduler::read_reply(entry& en, bool& timed_out) {
+    auto deadline = std::chrono::steady_clock::now() + en.timeout;
+    std::string data;
+    std::array<char, 1024> buf;
+    auto frames = std::vector<sl::io::span<const char>>();
+    for (;;) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            timed_out = true;
+            return std::string();
+        }
+        auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now);
+        uint32_t read = conn.read_available({buf.data(), buf.size()},
+                static_cast<uint32_t>(std::max(wait.count(), static_cast<decltype(wait.count())>(1))));
+        if (0 == read) {
+            continue;
+        }
+        data.append(buf.data(), read);
+        frames.clear();
+        size_t consumed = en.parser->parse({data.data(), data.length()}, 1, frames);
+        if (!frames.empty()) {
+            // bytes after the reply are stale, next request expects its own reply
+            return std::string(frames.front().data(), frames.front().size());
+        }
+        data.erase(0, consumed);
+    }
+}
+
+} // namespace
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   poll_scheduler.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 06:20 PM
+ */
+
+#ifndef WILTON_SERIAL_POLL_SCHEDULER_HPP
+#define WILTON_SERIAL_POLL_SCHEDULER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/json.hpp"
+
+#include "connection.hpp"
+#include "frame_parser.hpp"
+
+namespace wilton {
+namespace serial {
+
+/**
+ * Sends the configured requests periodically from the dedicated thread
+ * and keeps the latest replies, so the polling timing does not depend
+ * on the caller scheduling; input left from the previous exchanges
+ * is discarded before each request
+ *
+ * Each exchange is done under the connection I/O mutex, direct reads
+ * and writes must be rejected by the caller while the scheduler is running.
+ */
+class poll_scheduler {
+    class reply {
+    public:
+        uint64_t timestamp_millis;
+        uint64_t latency_micros;
+        std::string data;
+        bool timed_out;
+
+        reply(uint64_t timestamp_millis, uint64_t latency_micros, std::string&& data, bool timed_out) :
+        timestamp_millis(timestamp_millis),
+        latency_micros(latency_micros),
+        data(std::move(data)),
+        timed_out(timed_out) { }
+    };
+
+    class entry {
+    public:
+        std::string request;
+        std::chrono::milliseconds period;
+        std::chrono::milliseconds timeout;
+        std::string framing;
+        std::unique_ptr<frame_parser> parser;
+        std::chrono::steady_clock::time_point next_due;
+        std::deque<reply> history;
+        uint64_t polls_count = 0;
+        uint64_t timeouts_count = 0;
+        uint64_t missed_slots_count = 0;
+        uint64_t bytes_skipped = 0;
+        uint64_t stale_bytes_count = 0;
+
+        explicit entry(const sl::json::value& json);
+    };
+
+    connection& conn;
+    std::mutex& io_mutex;
+    uint32_t history_size;
+    std::vector<entry> entries;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::string bg_error;
+    bool stopping = false;
+    std::thread poller;
+
+public:
+    /**
+     * Constructor, starts polling thread
+     *
+     * @param conn connection, must outlive the scheduler
+     * @param io_mutex mutex that serializes the calls to the connection
+     * @param conf JSON with "entries" (list of "requestHex", "periodMillis",
+     *        "framing", "timeoutMillis", "maxFrameLength") and "historySize"
+     */
+    poll_scheduler(connection& conn, std::mutex& io_mutex, const sl::json::value& conf);
+
+    poll_scheduler(const poll_scheduler&) = delete;
+
+    poll_scheduler& operator=(const poll_scheduler&) = delete;
+
+    /**
+     * Stops polling thread, waits for the request in progress
+     */
+    ~poll_scheduler() STATICLIB_NOEXCEPT;
+
+    /**
+     * Latest replies and counters for all entries
+     *
+     * @return list of entry results, replies are hex-encoded, oldest first
+     */
+    sl::json::value results();
+
+private:
+    void run() STATICLIB_NOEXCEPT;
+
+    void poll_entry(entry& en);
+
+    uint64_t discard_input();
+
+    std::string read_reply(entry& en, bool& timed_out);
+
+    void schedule_next(entry& en, std::chrono::steady_clock::time_point now);
+};
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_POLL_SCHEDULER_HPP */
@@ -0,0 +1,221 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   port_scanner.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 10:14 AM
+ */
+
+#include "port_scanner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#ifndef STATICLIB_WINDOWS
+#include <glob.h>
+#endif // !STATICLIB_WINDOWS
+
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "wilton/support/exception.hpp"
+
+#include "connection.hpp"
+#include "serial_config.hpp"
+
+namespace wilton {
+namespace serial {
+
+namespace { // anonymous
+
+void expand_port_pattern(const std::string& pattern, std::vector<std::string>& dest) {
+#ifndef STATICLIB_WINDOWS
+    glob_t gl;
+    auto err = ::glob(pattern.c_str(), 0, nullptr, std::addressof(gl));
+    auto deferred = sl::support::defer([&gl]() STATICLIB_NOEXCEPT {
+        ::globfree(std::addressof(gl));
+    });
+    if (0 == err) {
+        for (size_t i = 0; i < gl.gl_pathc; i++) {
+            dest.emplace_back(gl.gl_pathv[i]);
+        }
+    } else if (GLOB_NOMATCH != err) {
+        throw support::exception(TRACEMSG(
+                "Serial scan 'glob' error, pattern: [" + pattern + "]," +
+                " code: [" + sl::support::to_string(err) + "]"));
+    }
+#else // STATICLIB_WINDOWS
+    // COM port names are listed explicitly
+    dest.push_back(pattern);
+#endif // !STATICLIB_WINDOWS
+}
+
+sl::json::value make_port_config(const std::string& port, const sl::json::value& variant) {
+    auto fields = std::vector<sl::json::field>();
+    fields.emplace_back("port", port);
+    for (const sl::json::field& fi : variant.as_object()) {
+        fields.emplace_back(fi.name(), fi.val().clone());
+    }
+    return sl::json::value(std::move(fields));
+}
+
+} // namespace
+
+port_scanner::port_scanner(const sl::json::value& json) {
+    auto rprobehex = std::ref(sl::utils::empty_string());
+    auto rexpectedhex = std::ref(sl::utils::empty_string());
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("ports" == name) {
+            for (const sl::json::value& va : fi.as_array_or_throw(name)) {
+                expand_port_pattern(va.as_string_nonempty_or_throw(name), this->ports);
+            }
+        } else if ("configs" == name) {
+            for (const sl::json::value& va : fi.as_array_or_throw(name)) {
+                for (const sl::json::field& vfi : va.as_object_or_throw(name)) {
+                    if ("port" == vfi.name()) throw support::exception(TRACEMSG(
+                            "Invalid 'configs' entry, 'port' must not be specified,"
+                            " value: [" + va.dumps() + "]"));
+                }
+                this->configs.emplace_back(va.clone());
+            }
+        } else if ("probeHex" == name) {
+            rprobehex = fi.as_string_nonempty_or_throw(name);
+        } else if ("responseHex" == name) {
+            rexpectedhex = fi.as_string_nonempty_or_throw(name);
+        } else if ("responseMaxLength" == name) {
+            this->response_max_length = fi.as_uint32_positive_or_throw(name);
+        } else if ("threadsCount" == name) {
+            this->threads_count = fi.as_uint32_positive_or_throw(name);
+        } else if ("stopOnFirstMatch" == name) {
+            this->stop_on_first_match = fi.as_bool_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown 'serial_scan' field: [" + name + "]"));
+        }
+    }
+    if (configs.empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'configs' not specified"));
+    if (rprobehex.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'probeHex' not specified"));
+    if (rexpectedhex.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'responseHex' not specified"));
+    this->probe = sl::io::string_from_hex(rprobehex.get());
+    this->expected = sl::io::string_from_hex(rexpectedhex.get());
+    // the same device may be matched by multiple patterns
+    std::sort(ports.begin(), ports.end());
+    ports.erase(std::unique(ports.begin(), ports.end()), ports.end());
+}
+
+std::vector<sl::json::value> port_scanner::scan() {
+    auto results = std::vector<std::vector<sl::json::value>>();
+    results.resize(ports.size());
+    std::atomic<size_t> next(0);
+    // exceptions must not leave the worker thread
+    auto record_error = [](std::vector<sl::json::value>& dest, const std::string& port,
+            const std::string& msg) STATICLIB_NOEXCEPT {
+        try {
+            dest.clear();
+            dest.emplace_back(sl::json::value({
+                { "port", port },
+                { "error", msg }
+            }));
+        } catch (...) {
+            // no memory to report the error
+        }
+    };
+    auto worker = [this, &results, &next, &record_error]() STATICLIB_NOEXCEPT {
+        for (;;) {
+            size_t idx = next.fetch_add(1);
+            if (idx >= ports.size()) {
+                break;
+            }
+            try {
+                results[idx] = probe_port(ports[idx]);
+            } catch (const std::exception& e) {
+                record_error(results[idx], ports[idx], e.what());
+            } catch (...) {
+                record_error(results[idx], ports[idx], "Unknown error");
+            }
+        }
+    };
+    auto threads = std::vector<std::thread>();
+    size_t count = std::min(static_cast<size_t>(threads_count), ports.size());
+    for (size_t i = 0; i < count; i++) {
+        threads.emplace_back(worker);
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    auto res = std::vector<sl::json::value>();
+    for (auto& vec : results) {
+        for (auto& va : vec) {
+            res.emplace_back(std::move(va));
+        }
+    }
+    return res;
+}
+
+std::vector<sl::json::value> port_scanner::probe_port(const std::string& port) {
+    auto res = std::vector<sl::json::value>();
+    for (const sl::json::value& variant : configs) {
+        try {
+            auto conf = serial_config(make_port_config(port, variant));
+            auto conf_json = conf.to_json();
+            auto conn = connection(std::move(conf));
+            conn.write({probe.data(), probe.length()});
+            uint64_t finish = sl::utils::current_time_millis_steady() + conn.config().timeout_millis;
+            std::string resp;
+            resp.resize(response_max_length);
+            size_t filled = 0;
+            while (filled < resp.length()) {
+                uint64_t cur = sl::utils::current_time_millis_steady();
+                if (cur >= finish) {
+                    break;
+                }
+                // whatever arrived so far, in one call
+                uint32_t read = conn.read_available({std::addressof(resp.front()) + filled, resp.length() - filled},
+                        static_cast<uint32_t>(finish - cur));
+                if (0 == read) {
+                    break;
+                }
+                // match may span the chunk boundary
+                size_t from = filled < expected.length() ? 0 : filled - expected.length() + 1;
+                filled += read;
+                auto end = resp.begin() + filled;
+                if (end != std::search(resp.begin() + from, end, expected.begin(), expected.end())) {
+                    resp.resize(filled);
+                    auto fields = std::move(conf_json.as_object_or_throw());
+                    fields.emplace_back("responseHex", sl::io::string_to_hex(resp));
+                    res.emplace_back(std::move(fields));
+                    break;
+                }
+            }
+        } catch (const std::exception&) {
+            // port cannot be opened with this config, or I/O failed, skip it
+        }
+        if (stop_on_first_match && !res.empty()) {
+            break;
+        }
+    }
+    return res;
+}
+
+} // namespace
+}
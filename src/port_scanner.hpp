@@ -0,0 +1,74 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   port_scanner.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 10:12 AM
+ */
+
+#ifndef WILTON_SERIAL_PORT_SCANNER_HPP
+#define WILTON_SERIAL_PORT_SCANNER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/json.hpp"
+
+namespace wilton {
+namespace serial {
+
+/**
+ * Probes a set of ports with a set of config variants in parallel,
+ * ports are probed concurrently, variants for the same port - sequentially
+ */
+class port_scanner {
+    std::vector<std::string> ports;
+    std::vector<sl::json::value> configs;
+    std::string probe;
+    std::string expected;
+    uint32_t response_max_length = 256;
+    uint32_t threads_count = 16;
+    bool stop_on_first_match = true;
+
+public:
+    port_scanner(const sl::json::value& json);
+
+    port_scanner(const port_scanner&) = delete;
+
+    port_scanner& operator=(const port_scanner&) = delete;
+
+    /**
+     * Runs the scan
+     *
+     * @return list of matched configs, each with a 'responseHex' field;
+     *         ports that failed outside of the probing itself are listed
+     *         with 'port' and 'error' fields
+     */
+    std::vector<sl::json::value> scan();
+
+private:
+    std::vector<sl::json::value> probe_port(const std::string& port);
+};
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_PORT_SCANNER_HPP */
+
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   probes.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 05:45 PM
+ */
+
+#ifndef WILTON_SERIAL_PROBES_HPP
+#define WILTON_SERIAL_PROBES_HPP
+
+// Static tracepoints (USDT) for bpftrace/perf, provider: "wilton_serial".
+// Probes compile to a single nop when no tracer is attached, arguments
+// are evaluated only when WILTON_SERIAL_USDT is defined (sys/sdt.h is available).
+//
+// open(fd, port)                termios, port opened
+// close(fd)                     termios, port closed
+// poll_enter(fd, timeout_ms)    termios, before poll
+// poll_exit(fd, ret, ns)        termios, after poll, ret is the poll result
+// read(fd, bytes)               termios, bytes returned by read(2)
+// write(fd, bytes)              termios, bytes returned by write(2)
+// timeout(fd, bytes, ns)        termios, read deadline expired with partial data
+// api_open(handle)              C API, connection opened
+// api_read(handle, bytes, ns)   C API, read call completed
+// api_write(handle, bytes, ns)  C API, write call completed
+// api_close(handle)             C API, connection closed
+
+#ifdef WILTON_SERIAL_USDT
+
+#include <chrono>
+#include <cstdint>
+
+#include <sys/sdt.h>
+
+#define WILTON_SERIAL_PROBE1(name, a1) DTRACE_PROBE1(wilton_serial, name, a1)
+#define WILTON_SERIAL_PROBE2(name, a1, a2) DTRACE_PROBE2(wilton_serial, name, a1, a2)
+#define WILTON_SERIAL_PROBE3(name, a1, a2, a3) DTRACE_PROBE3(wilton_serial, name, a1, a2, a3)
+#define WILTON_SERIAL_PROBE_NANOS() static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>( \
+        std::chrono::steady_clock::now().time_since_epoch()).count())
+
+#else // !WILTON_SERIAL_USDT
+
+// sizeof marks the arguments as used without evaluating them
+#define WILTON_SERIAL_PROBE1(name, a1) do { (void) sizeof(a1); } while (0)
+#define WILTON_SERIAL_PROBE2(name, a1, a2) do { (void) sizeof(a1); (void) sizeof(a2); } while (0)
+#define WILTON_SERIAL_PROBE3(name, a1, a2, a3) do { (void) sizeof(a1); (void) sizeof(a2); (void) sizeof(a3); } while (0)
+#define WILTON_SERIAL_PROBE_NANOS() static_cast<uint64_t>(0)
+
+#endif // WILTON_SERIAL_USDT
+
+#endif /* WILTON_SERIAL_PROBES_HPP */
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   profile_registry.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 10:36 PM
+ */
+
+#include "profile_registry.hpp"
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "wilton/support/exception.hpp"
+
+namespace wilton {
+namespace serial {
+
+namespace { // anonymous
+
+std::mutex& registry_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::map<std::string, serial_config>& registry() {
+    static std::map<std::string, serial_config> profiles;
+    return profiles;
+}
+
+} // namespace
+
+void register_profile(const std::string& name, const sl::json::value& conf) {
+    if (name.empty()) throw support::exception(TRACEMSG("Invalid empty profile name specified"));
+    auto sconf = serial_config(conf, false);
+    sconf.precompiled = std::make_shared<const line_settings>(compile_line_settings(sconf));
+    std::lock_guard<std::mutex> guard{registry_mutex()};
+    auto& reg = registry();
+    auto it = reg.find(name);
+    if (reg.end() != it) {
+        it->second = std::move(sconf);
+    } else {
+        reg.emplace(name, std::move(sconf));
+    }
+}
+
+void unregister_profile(const std::string& name) {
+    std::lock_guard<std::mutex> guard{registry_mutex()};
+    auto erased = registry().erase(name);
+    if (0 == erased) throw support::exception(TRACEMSG(
+            "Serial profile not found, name: [" + name + "]"));
+}
+
+serial_config profile_config(const std::string& name, const std::string& port) {
+    std::lock_guard<std::mutex> guard{registry_mutex()};
+    auto& reg = registry();
+    auto it = reg.find(name);
+    if (reg.end() == it) throw support::exception(TRACEMSG(
+            "Serial profile not found, name: [" + name + "]"));
+    auto res = it->second.clone();
+    if (!port.empty()) {
+        res.port = port;
+    }
+    if (res.port.empty()) throw support::exception(TRACEMSG(
+            "Port not specified for serial profile, name: [" + name + "]"));
+    return res;
+}
+
+} // namespace
+}
+
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   profile_registry.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 10:32 PM
+ */
+
+#ifndef WILTON_SERIAL_PROFILE_REGISTRY_HPP
+#define WILTON_SERIAL_PROFILE_REGISTRY_HPP
+
+#include <string>
+
+#include "staticlib/json.hpp"
+
+#include "serial_config.hpp"
+
+namespace wilton {
+namespace serial {
+
+/**
+ * Parses, validates and compiles the config once and stores it
+ * under the specified name, existing profile with the same name is replaced
+ *
+ * @param name profile name
+ * @param conf connection config, "port" is optional
+ */
+void register_profile(const std::string& name, const sl::json::value& conf);
+
+/**
+ * Removes the registered profile, connections opened with it are not affected
+ *
+ * @param name profile name
+ */
+void unregister_profile(const std::string& name);
+
+/**
+ * Config of the registered profile, ready to be passed to the connection
+ *
+ * @param name profile name
+ * @param port port to open, profile port is used if empty
+ * @return config copy sharing the compiled line settings
+ */
+serial_config profile_config(const std::string& name, const std::string& port);
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_PROFILE_REGISTRY_HPP */
@@ -0,0 +1,188 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   read_many.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 08:08 PM
+ */
+
+#include "read_many.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#ifndef STATICLIB_WINDOWS
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#endif // !STATICLIB_WINDOWS
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "wilton/support/exception.hpp"
+
+#include "hex_codec.hpp"
+
+namespace wilton {
+namespace serial {
+
+namespace { // anonymous
+
+// read timeout for the lost ports, reconnect attempt sleeps
+// for the backoff delay bounded by it
+const uint32_t lost_port_slice_millis = 10;
+
+#ifndef STATICLIB_WINDOWS
+
+// marks connections that have data and lost connections,
+// returns false on timeout
+bool wait_readable(const std::vector<connection*>& conns, uint32_t timeout_millis,
+        std::vector<bool>& ready, std::vector<bool>& lost) {
+    auto pfds = std::vector<struct pollfd>();
+    auto idxs = std::vector<size_t>();
+    bool found = false;
+    for (size_t i = 0; i < conns.size(); i++) {
+        if (conns[i]->has_unread()) {
+            ready[i] = true;
+            found = true;
+        }
+        int fd = conns[i]->poll_fd();
+        if (-1 == fd) {
+            // read reopens the port or reports the error
+            ready[i] = true;
+            lost[i] = true;
+        } else {
+            struct pollfd pfd;
+            std::memset(std::addressof(pfd), '\0', sizeof(pfd));
+            pfd.fd = fd;
+            pfd.events = POLLIN;
+            pfds.push_back(pfd);
+            idxs.push_back(i);
+        }
+    }
+    if (pfds.empty()) {
+        return found || std::find(lost.begin(), lost.end(), true) != lost.end();
+    }
+    // buffered data is returned without waiting, lost ports do their own waiting
+    bool any_lost = std::find(lost.begin(), lost.end(), true) != lost.end();
+    int timeout = found || any_lost ? 0 : static_cast<int>(timeout_millis);
+    auto err = ::poll(pfds.data(), static_cast<nfds_t>(pfds.size()), timeout);
+    if (err < 0 && EINTR != errno) throw support::exception(TRACEMSG(
+            "Serial 'poll' error, ports count: [" + sl::support::to_string(pfds.size()) + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+    for (size_t j = 0; err > 0 && j < pfds.size(); j++) {
+        // errors and hangups are reported by the read
+        if (0 != pfds[j].revents) {
+            ready[idxs[j]] = true;
+            found = true;
+        }
+    }
+    return found || any_lost;
+}
+
+#else // STATICLIB_WINDOWS
+
+// receive events are armed only inside the reads, there is nothing to wait on together,
+// readiness is checked by the zero-timeout reads in read_many
+bool wait_readable(const std::vector<connection*>& conns, uint32_t,
+        std::vector<bool>& ready, std::vector<bool>&) {
+    for (size_t i = 0; i < conns.size(); i++) {
+        ready[i] = true;
+    }
+    return true;
+}
+
+#endif // !STATICLIB_WINDOWS
+
+} // namespace
+
+sl::json::value read_many(const std::vector<connection*>& conns, const std::vector<std::string>& keys,
+        uint32_t max_length, uint32_t timeout_millis) {
+    if (!keys.empty() && keys.size() != conns.size()) throw support::exception(TRACEMSG(
+            "Invalid keys count: [" + sl::support::to_string(keys.size()) + "]," +
+            " ports count: [" + sl::support::to_string(conns.size()) + "]"));
+    uint64_t finish = sl::utils::current_time_millis_steady() + timeout_millis;
+    auto ready = std::vector<bool>(conns.size(), false);
+    auto lost = std::vector<bool>(conns.size(), false);
+    auto data = std::vector<std::string>(conns.size());
+    auto errors = std::vector<std::string>(conns.size());
+    std::string buf;
+    buf.resize(max_length);
+    for (;;) {
+        std::fill(ready.begin(), ready.end(), false);
+        std::fill(lost.begin(), lost.end(), false);
+        uint64_t cur = sl::utils::current_time_millis_steady();
+        uint32_t wait = cur < finish ? static_cast<uint32_t>(finish - cur) : 0;
+        bool found = false;
+        if (wait_readable(conns, wait, ready, lost)) {
+            for (size_t i = 0; i < conns.size(); i++) {
+                if (!ready[i]) {
+                    continue;
+                }
+                uint32_t slice = lost[i] ? std::min(wait, lost_port_slice_millis) : 0;
+                try {
+                    uint32_t read = conns[i]->read_available({std::addressof(buf.front()), buf.length()}, slice);
+                    data[i].assign(buf.data(), read);
+                } catch (const std::exception& e) {
+                    errors[i] = e.what();
+                }
+                found = found || !data[i].empty() || !errors[i].empty();
+            }
+        }
+        if (found || sl::utils::current_time_millis_steady() >= finish) {
+            break;
+        }
+#ifdef STATICLIB_WINDOWS
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+#endif // STATICLIB_WINDOWS
+    }
+    if (!keys.empty()) {
+        auto fields = std::vector<sl::json::field>();
+        for (size_t i = 0; i < conns.size(); i++) {
+            if (!errors[i].empty()) {
+                fields.emplace_back(keys[i], sl::json::value({
+                    { "error", errors[i] }
+                }));
+            } else if (!data[i].empty()) {
+                fields.emplace_back(keys[i], sl::json::value({
+                    { "dataHex", hex_encode(data[i]) }
+                }));
+            }
+        }
+        return sl::json::value(std::move(fields));
+    }
+    auto res = std::vector<sl::json::value>();
+    for (size_t i = 0; i < conns.size(); i++) {
+        if (!errors[i].empty()) {
+            res.emplace_back(sl::json::value({
+                { "error", errors[i] }
+            }));
+        } else {
+            res.emplace_back(sl::json::value({
+                { "dataHex", hex_encode(data[i]) }
+            }));
+        }
+    }
+    return sl::json::value(std::move(res));
+}
+
+} // namespace
+}
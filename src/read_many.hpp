@@ -0,0 +1,61 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   read_many.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 08:05 PM
+ */
+
+#ifndef WILTON_SERIAL_READ_MANY_HPP
+#define WILTON_SERIAL_READ_MANY_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/json.hpp"
+
+#include "connection.hpp"
+
+namespace wilton {
+namespace serial {
+
+/**
+ * Waits for the incoming data on all the specified connections at once
+ * (single poll call on Linux), then reads whatever data is available
+ * from every ready connection without further waiting
+ *
+ * Disconnected ports are reopened by their reads in short slices,
+ * the wait is not spun while no port can be polled.
+ *
+ * @param conns connections
+ * @param keys result keys for the connections, may be empty
+ * @param max_length max number of bytes to read from each connection
+ * @param timeout_millis max time to wait for the data on any connection
+ * @return if keys are empty - array with an element for each connection,
+ *         otherwise - object with the ports that have data or errors only;
+ *         each element is an object with either "dataHex" or "error"
+ */
+sl::json::value read_many(const std::vector<connection*>& conns, const std::vector<std::string>& keys,
+        uint32_t max_length, uint32_t timeout_millis);
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_READ_MANY_HPP */
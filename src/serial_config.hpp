@@ -25,6 +25,7 @@
 #define WILTON_SERIAL_SERIAL_CONFIG_HPP
 
 #include <cstdint>
+#include <memory>
 #include <string>
 
 #include "staticlib/config.hpp"
@@ -33,6 +34,8 @@
 
 #include "wilton/support/exception.hpp"
 
+#include "flush_type.hpp"
+#include "line_settings.hpp"
 #include "parity_type.hpp"
 
 namespace wilton {
@@ -46,8 +49,28 @@ public:
     uint16_t byte_size = 8;
     uint16_t stop_bits_count = 1;
     uint32_t timeout_millis = 500;
-
-    serial_config(const serial_config&) = delete;
+    bool reconnect = false;
+    uint32_t reconnect_backoff_min_millis = 100;
+    uint32_t reconnect_backoff_max_millis = 5000;
+    uint32_t coalesce_micros = 0;
+    uint32_t coalesce_max_bytes = 4096;
+    bool rs485 = false;
+    bool rs485_rts_on_send = true;
+    bool rs485_rts_after_send = false;
+    uint32_t rs485_delay_before_send_millis = 0;
+    uint32_t rs485_delay_after_send_millis = 0;
+    uint32_t fanout_buffer_size = 65536;
+    uint32_t read_pool_size = 4;
+    bool exclusive = false;
+    uint32_t exclusive_wait_millis = 0;
+    flush_type flush_on_open = flush_type::input;
+    // input modem lines poll interval, lines are polled only during the waits
+    uint32_t modem_poll_millis = 10;
+    // driver queue sizes, applied on Windows only, tty layer sizes its buffers itself
+    uint32_t rx_queue_size = 4096;
+    uint32_t tx_queue_size = 4096;
+    // set for the configs taken from registered profiles
+    std::shared_ptr<const line_settings> precompiled;
 
     serial_config& operator=(const serial_config&) = delete;
 
@@ -57,7 +80,26 @@ public:
     parity(other.parity),
     byte_size(other.byte_size),
     stop_bits_count(other.stop_bits_count),
-    timeout_millis(other.timeout_millis) { }
+    timeout_millis(other.timeout_millis),
+    reconnect(other.reconnect),
+    reconnect_backoff_min_millis(other.reconnect_backoff_min_millis),
+    reconnect_backoff_max_millis(other.reconnect_backoff_max_millis),
+    coalesce_micros(other.coalesce_micros),
+    coalesce_max_bytes(other.coalesce_max_bytes),
+    rs485(other.rs485),
+    rs485_rts_on_send(other.rs485_rts_on_send),
+    rs485_rts_after_send(other.rs485_rts_after_send),
+    rs485_delay_before_send_millis(other.rs485_delay_before_send_millis),
+    rs485_delay_after_send_millis(other.rs485_delay_after_send_millis),
+    fanout_buffer_size(other.fanout_buffer_size),
+    read_pool_size(other.read_pool_size),
+    exclusive(other.exclusive),
+    exclusive_wait_millis(other.exclusive_wait_millis),
+    flush_on_open(other.flush_on_open),
+    modem_poll_millis(other.modem_poll_millis),
+    rx_queue_size(other.rx_queue_size),
+    tx_queue_size(other.tx_queue_size),
+    precompiled(std::move(other.precompiled)) { }
 
     serial_config& operator=(serial_config&& other) {
         port = std::move(other.port);
@@ -66,12 +108,37 @@ public:
         byte_size = other.byte_size;
         stop_bits_count = other.stop_bits_count;
         timeout_millis = other.timeout_millis;
+        reconnect = other.reconnect;
+        reconnect_backoff_min_millis = other.reconnect_backoff_min_millis;
+        reconnect_backoff_max_millis = other.reconnect_backoff_max_millis;
+        coalesce_micros = other.coalesce_micros;
+        coalesce_max_bytes = other.coalesce_max_bytes;
+        rs485 = other.rs485;
+        rs485_rts_on_send = other.rs485_rts_on_send;
+        rs485_rts_after_send = other.rs485_rts_after_send;
+        rs485_delay_before_send_millis = other.rs485_delay_before_send_millis;
+        rs485_delay_after_send_millis = other.rs485_delay_after_send_millis;
+        fanout_buffer_size = other.fanout_buffer_size;
+        read_pool_size = other.read_pool_size;
+        exclusive = other.exclusive;
+        exclusive_wait_millis = other.exclusive_wait_millis;
+        flush_on_open = other.flush_on_open;
+        modem_poll_millis = other.modem_poll_millis;
+        rx_queue_size = other.rx_queue_size;
+        tx_queue_size = other.tx_queue_size;
+        precompiled = std::move(other.precompiled);
         return *this;
     }
 
     serial_config() { }
     
-    serial_config(const sl::json::value& json) {
+    /**
+     * Parses and validates the config
+     *
+     * @param json config JSON
+     * @param require_port false for profiles, port is specified on open
+     */
+    serial_config(const sl::json::value& json, bool require_port = true) {
         for (const sl::json::field& fi : json.as_object()) {
             auto& name = fi.name();
             if ("port" == name) {
@@ -86,12 +153,59 @@ public:
                 this->stop_bits_count = fi.as_uint16_positive_or_throw(name);
             } else if ("timeoutMillis" == name) {
                 this->timeout_millis = fi.as_uint32_positive_or_throw(name);
+            } else if ("reconnect" == name) {
+                this->reconnect = fi.as_bool_or_throw(name);
+            } else if ("reconnectBackoffMinMillis" == name) {
+                this->reconnect_backoff_min_millis = fi.as_uint32_positive_or_throw(name);
+            } else if ("reconnectBackoffMaxMillis" == name) {
+                this->reconnect_backoff_max_millis = fi.as_uint32_positive_or_throw(name);
+            } else if ("coalesceMicros" == name) {
+                this->coalesce_micros = fi.as_uint32_or_throw(name);
+            } else if ("coalesceMaxBytes" == name) {
+                this->coalesce_max_bytes = fi.as_uint32_positive_or_throw(name);
+            } else if ("rs485" == name) {
+                this->rs485 = fi.as_bool_or_throw(name);
+            } else if ("rs485RtsOnSend" == name) {
+                this->rs485_rts_on_send = fi.as_bool_or_throw(name);
+            } else if ("rs485RtsAfterSend" == name) {
+                this->rs485_rts_after_send = fi.as_bool_or_throw(name);
+            } else if ("rs485DelayBeforeSendMillis" == name) {
+                this->rs485_delay_before_send_millis = fi.as_uint32_or_throw(name);
+            } else if ("rs485DelayAfterSendMillis" == name) {
+                this->rs485_delay_after_send_millis = fi.as_uint32_or_throw(name);
+            } else if ("fanoutBufferSize" == name) {
+                this->fanout_buffer_size = fi.as_uint32_positive_or_throw(name);
+            } else if ("readPoolSize" == name) {
+                this->read_pool_size = fi.as_uint32_or_throw(name);
+            } else if ("exclusive" == name) {
+                this->exclusive = fi.as_bool_or_throw(name);
+            } else if ("exclusiveWaitMillis" == name) {
+                this->exclusive_wait_millis = fi.as_uint32_or_throw(name);
+            } else if ("flushOnOpen" == name) {
+                this->flush_on_open = make_flush_type(fi.as_string_nonempty_or_throw(name));
+            } else if ("modemPollMillis" == name) {
+                this->modem_poll_millis = fi.as_uint32_positive_or_throw(name);
+            } else if ("rxQueueSize" == name) {
+                this->rx_queue_size = fi.as_uint32_positive_or_throw(name);
+            } else if ("txQueueSize" == name) {
+                this->tx_queue_size = fi.as_uint32_positive_or_throw(name);
             } else {
                 throw support::exception(TRACEMSG("Unknown 'serial_config' field: [" + name + "]"));
             }
         }
-        if (port.empty()) throw support::exception(TRACEMSG(
+        if (require_port && port.empty()) throw support::exception(TRACEMSG(
                 "Invalid 'serial.port' field: []"));
+        if (reconnect_backoff_max_millis < reconnect_backoff_min_millis) throw support::exception(TRACEMSG(
+                "Invalid 'serial.reconnectBackoffMaxMillis' field,"
+                " min: [" + sl::support::to_string(reconnect_backoff_min_millis) + "],"
+                " max: [" + sl::support::to_string(reconnect_backoff_max_millis) + "]"));
+        // queued data is written from the background thread, port cannot be reopened under it
+        if (reconnect && coalesce_micros > 0) throw support::exception(TRACEMSG(
+                "Invalid 'serial.coalesceMicros' field: [" + sl::support::to_string(coalesce_micros) + "],"
+                " write coalescing cannot be used together with 'reconnect'"));
+        if (!exclusive && exclusive_wait_millis > 0) throw support::exception(TRACEMSG(
+                "Invalid 'serial.exclusiveWaitMillis' field: [" + sl::support::to_string(exclusive_wait_millis) + "],"
+                " lock wait can only be used together with 'exclusive'"));
     }
 
     sl::json::value to_json() const {
@@ -102,8 +216,38 @@ public:
             { "byteSize", byte_size },
             { "stopBitsCount", stop_bits_count },
             { "timeoutMillis", timeout_millis },
+            { "reconnect", reconnect },
+            { "reconnectBackoffMinMillis", reconnect_backoff_min_millis },
+            { "reconnectBackoffMaxMillis", reconnect_backoff_max_millis },
+            { "coalesceMicros", coalesce_micros },
+            { "coalesceMaxBytes", coalesce_max_bytes },
+            { "rs485", rs485 },
+            { "rs485RtsOnSend", rs485_rts_on_send },
+            { "rs485RtsAfterSend", rs485_rts_after_send },
+            { "rs485DelayBeforeSendMillis", rs485_delay_before_send_millis },
+            { "rs485DelayAfterSendMillis", rs485_delay_after_send_millis },
+            { "fanoutBufferSize", fanout_buffer_size },
+            { "readPoolSize", read_pool_size },
+            { "exclusive", exclusive },
+            { "exclusiveWaitMillis", exclusive_wait_millis },
+            { "flushOnOpen", stringify_flush_type(flush_on_open) },
+            { "modemPollMillis", modem_poll_millis },
+            { "rxQueueSize", rx_queue_size },
+            { "txQueueSize", tx_queue_size },
         };
     }
+
+    /**
+     * Copy of this config, shares the precompiled settings
+     *
+     * @return config copy
+     */
+    serial_config clone() const {
+        return serial_config(*this);
+    }
+
+private:
+    serial_config(const serial_config&) = default;
 };
 
 
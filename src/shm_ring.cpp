@@ -0,0 +1,260 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   shm_ring.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 09:44 PM
+ */
+
+#include "shm_ring.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <new>
+
+#ifdef STATICLIB_WINDOWS
+#include "staticlib/support/windows.hpp"
+#else // !STATICLIB_WINDOWS
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif // STATICLIB_WINDOWS
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "wilton/support/exception.hpp"
+
+namespace wilton {
+namespace serial {
+
+namespace { // anonymous
+
+const uint32_t ring_magic = 0x42525357; // "WSRB"
+const uint32_t ring_version = 1;
+
+// port read timeout, limits the stop latency and the time
+// the control calls wait for the I/O mutex
+const uint32_t pump_wait_millis = 50;
+
+uint32_t next_segment_id() {
+    static std::atomic<uint32_t> counter{0};
+    return counter.fetch_add(1);
+}
+
+#ifdef STATICLIB_WINDOWS
+uint32_t process_id() {
+    return static_cast<uint32_t>(::GetCurrentProcessId());
+}
+#else // !STATICLIB_WINDOWS
+uint32_t process_id() {
+    return static_cast<uint32_t>(::getpid());
+}
+#endif // STATICLIB_WINDOWS
+
+} // namespace
+
+shm_ring::shm_ring(connection& conn, std::mutex& io_mutex, const sl::json::value& conf) :
+conn(conn),
+io_mutex(io_mutex),
+capacity(1 << 20) {
+    static_assert(sizeof(header) <= header_size, "Invalid shared ring header size");
+    for (const sl::json::field& fi : conf.as_object()) {
+        auto& name = fi.name();
+        if ("capacity" == name) {
+            this->capacity = fi.as_uint32_positive_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown shared ring field: [" + name + "]"));
+        }
+    }
+    this->mapped_size = header_size + static_cast<size_t>(capacity);
+    create_segment();
+    auto hd = new (mapped) header();
+    hd->magic = ring_magic;
+    hd->version = ring_version;
+    hd->capacity = capacity;
+    try {
+        this->pump = std::thread([this] {
+            this->run();
+        });
+    } catch (...) {
+        remove_segment();
+        throw;
+    }
+}
+
+shm_ring::~shm_ring() STATICLIB_NOEXCEPT {
+    {
+        std::lock_guard<std::mutex> guard{mutex};
+        stopping = true;
+        cv.notify_all();
+    }
+    if (pump.joinable()) {
+        pump.join();
+    }
+    remove_segment();
+}
+
+sl::json::value shm_ring::info() const {
+    return {
+        { "name", name },
+        { "size", static_cast<uint64_t>(mapped_size) },
+        { "headerSize", static_cast<uint64_t>(header_size) },
+        { "capacity", capacity }
+    };
+}
+
+void shm_ring::advance(uint64_t length, uint32_t timeout_millis, uint64_t& read_pos_out,
+        uint64_t& write_pos_out) {
+    auto& hd = head();
+    std::unique_lock<std::mutex> guard{mutex};
+    uint64_t rpos = hd.read_pos.load(std::memory_order_relaxed);
+    uint64_t wpos = hd.write_pos.load(std::memory_order_acquire);
+    if (length > wpos - rpos) throw support::exception(TRACEMSG(
+            "Invalid consumed length specified: [" + sl::support::to_string(length) + "]," +
+            " available: [" + sl::support::to_string(wpos - rpos) + "]"));
+    rpos += length;
+    hd.read_pos.store(rpos, std::memory_order_release);
+    // freed space for the blocked receiving thread
+    cv.notify_all();
+    cv.wait_for(guard, std::chrono::milliseconds(timeout_millis), [this, &hd, rpos] {
+        return !bg_error.empty() || hd.write_pos.load(std::memory_order_acquire) > rpos;
+    });
+    wpos = hd.write_pos.load(std::memory_order_acquire);
+    // received data is still returned after the port failure
+    if (wpos == rpos && !bg_error.empty()) throw support::exception(TRACEMSG(
+            "Shared ring receive error: [" + bg_error + "]"));
+    read_pos_out = rpos;
+    write_pos_out = wpos;
+}
+
+shm_ring::header& shm_ring::head() {
+    return *reinterpret_cast<header*>(mapped);
+}
+
+#ifdef STATICLIB_WINDOWS
+
+void shm_ring::create_segment() {
+    this->name = "Local\\wilton_serial_" + sl::support::to_string(process_id()) +
+            "_" + sl::support::to_string(next_segment_id());
+    auto wname = sl::utils::widen(name);
+    uint64_t size = static_cast<uint64_t>(mapped_size);
+    HANDLE handle = ::CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+            static_cast<DWORD>(size >> 32), static_cast<DWORD>(size & 0xffffffff), wname.c_str());
+    if (nullptr == handle) throw support::exception(TRACEMSG(
+            "Shared ring 'CreateFileMappingW' error, name: [" + name + "],"
+            " size: [" + sl::support::to_string(size) + "],"
+            " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+    void* ptr = ::MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, mapped_size);
+    if (nullptr == ptr) {
+        auto code = ::GetLastError();
+        ::CloseHandle(handle);
+        throw support::exception(TRACEMSG(
+                "Shared ring 'MapViewOfFile' error, name: [" + name + "],"
+                " error: [" + sl::utils::errcode_to_string(code) + "]"));
+    }
+    this->mapping = handle;
+    this->mapped = static_cast<char*>(ptr);
+}
+
+void shm_ring::remove_segment() STATICLIB_NOEXCEPT {
+    ::UnmapViewOfFile(mapped);
+    ::CloseHandle(static_cast<HANDLE>(mapping));
+}
+
+#else // !STATICLIB_WINDOWS
+
+void shm_ring::create_segment() {
+    this->name = "/wilton_serial_" + sl::support::to_string(process_id()) +
+            "_" + sl::support::to_string(next_segment_id());
+    int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) throw support::exception(TRACEMSG(
+            "Shared ring 'shm_open' error, name: [" + name + "],"
+            " error: [" + ::strerror(errno) + "]"));
+    auto deferred = sl::support::defer([fd]() STATICLIB_NOEXCEPT {
+        ::close(fd);
+    });
+    if (0 != ::ftruncate(fd, static_cast<off_t>(mapped_size))) {
+        auto code = errno;
+        ::shm_unlink(name.c_str());
+        throw support::exception(TRACEMSG(
+                "Shared ring 'ftruncate' error, name: [" + name + "],"
+                " size: [" + sl::support::to_string(mapped_size) + "],"
+                " error: [" + ::strerror(code) + "]"));
+    }
+    void* ptr = ::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == ptr) {
+        auto code = errno;
+        ::shm_unlink(name.c_str());
+        throw support::exception(TRACEMSG(
+                "Shared ring 'mmap' error, name: [" + name + "],"
+                " error: [" + ::strerror(code) + "]"));
+    }
+    this->mapped = static_cast<char*>(ptr);
+}
+
+void shm_ring::remove_segment() STATICLIB_NOEXCEPT {
+    ::munmap(mapped, mapped_size);
+    ::shm_unlink(name.c_str());
+}
+
+#endif // STATICLIB_WINDOWS
+
+void shm_ring::run() STATICLIB_NOEXCEPT {
+    auto& hd = head();
+    char* data = mapped + header_size;
+    for (;;) {
+        // only this thread moves the write position
+        uint64_t wpos = hd.write_pos.load(std::memory_order_relaxed);
+        uint64_t space = 0;
+        {
+            std::unique_lock<std::mutex> guard{mutex};
+            // reader is behind, incoming data stays in the driver queue
+            cv.wait(guard, [this, &hd, wpos, &space] {
+                space = capacity - (wpos - hd.read_pos.load(std::memory_order_acquire));
+                return stopping || space > 0;
+            });
+            if (stopping) {
+                return;
+            }
+        }
+        size_t offset = static_cast<size_t>(wpos % capacity);
+        size_t len = static_cast<size_t>(std::min(space, capacity - offset));
+        uint32_t read = 0;
+        try {
+            std::lock_guard<std::mutex> io_guard{io_mutex};
+            read = conn.read_available({data + offset, len}, pump_wait_millis);
+        } catch (const std::exception& e) {
+            std::lock_guard<std::mutex> guard{mutex};
+            bg_error = e.what();
+            cv.notify_all();
+            return;
+        }
+        if (read > 0) {
+            std::lock_guard<std::mutex> guard{mutex};
+            hd.write_pos.store(wpos + read, std::memory_order_release);
+            cv.notify_all();
+        }
+    }
+}
+
+} // namespace
+}
+
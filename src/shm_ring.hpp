@@ -0,0 +1,132 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   shm_ring.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 09:40 PM
+ */
+
+#ifndef WILTON_SERIAL_SHM_RING_HPP
+#define WILTON_SERIAL_SHM_RING_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "staticlib/config.hpp"
+#include "staticlib/json.hpp"
+
+#include "connection.hpp"
+
+namespace wilton {
+namespace serial {
+
+/**
+ * Ring buffer in the named shared memory segment, filled directly from
+ * the port by the dedicated thread; reader maps the segment by name and
+ * only reports consumed bytes back, no data is copied on the read path
+ *
+ * Segment layout (little-endian, 64 bytes header followed by the data):
+ * uint32 magic "WSRB", uint32 version, uint64 capacity, uint64 write position,
+ * uint64 read position; positions are total byte counts, data for the position
+ * is at 'header_size + position % capacity'.
+ *
+ * Port reads are done under the connection I/O mutex, direct reads
+ * and writes must be rejected by the caller while the ring is active.
+ */
+class shm_ring {
+    class header {
+    public:
+        uint32_t magic;
+        uint32_t version;
+        uint64_t capacity;
+        std::atomic<uint64_t> write_pos;
+        std::atomic<uint64_t> read_pos;
+    };
+
+    connection& conn;
+    std::mutex& io_mutex;
+    std::string name;
+    uint64_t capacity;
+    size_t mapped_size = 0;
+    char* mapped = nullptr;
+    // file mapping handle on Windows
+    void* mapping = nullptr;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::string bg_error;
+    bool stopping = false;
+    std::thread pump;
+
+public:
+    static const size_t header_size = 64;
+
+    /**
+     * Constructor, creates the segment and starts receiving thread
+     *
+     * @param conn connection, must outlive the ring
+     * @param io_mutex mutex that serializes the calls to the connection
+     * @param conf JSON with "capacity" (data size in bytes)
+     */
+    shm_ring(connection& conn, std::mutex& io_mutex, const sl::json::value& conf);
+
+    shm_ring(const shm_ring&) = delete;
+
+    shm_ring& operator=(const shm_ring&) = delete;
+
+    /**
+     * Stops receiving thread, removes the segment name
+     */
+    ~shm_ring() STATICLIB_NOEXCEPT;
+
+    /**
+     * Segment name and layout for the reader
+     *
+     * @return object with "name", "size", "headerSize" and "capacity"
+     */
+    sl::json::value info() const;
+
+    /**
+     * Marks the data as consumed, then waits for more data
+     *
+     * @param length number of bytes consumed by the reader
+     * @param timeout_millis max time to wait for the unconsumed data
+     * @param read_pos_out read position after the advance
+     * @param write_pos_out write position after the wait
+     */
+    void advance(uint64_t length, uint32_t timeout_millis, uint64_t& read_pos_out,
+            uint64_t& write_pos_out);
+
+private:
+    header& head();
+
+    void create_segment();
+
+    void remove_segment() STATICLIB_NOEXCEPT;
+
+    void run() STATICLIB_NOEXCEPT;
+};
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_SHM_RING_HPP */
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   timestamped_read.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 01:12 PM
+ */
+
+#include "timestamped_read.hpp"
+
+#include <chrono>
+
+#include "staticlib/utils.hpp"
+
+namespace wilton {
+namespace serial {
+
+namespace { // anonymous
+
+void write_le(char* dest, uint64_t val, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        dest[i] = static_cast<char>((val >> (i * 8)) & 0xff);
+    }
+}
+
+uint64_t nanos(std::chrono::nanoseconds dur) {
+    return static_cast<uint64_t>(dur.count());
+}
+
+} // namespace
+
+std::string read_timestamped(connection& conn, uint32_t max_length, uint32_t timeout_millis,
+        const read_filter& filter) {
+    uint32_t timeout = timeout_millis > 0 ? timeout_millis : conn.config().timeout_millis;
+    uint64_t start = sl::utils::current_time_millis_steady();
+    uint64_t finish = start + timeout;
+    uint64_t cur = start;
+    std::string res;
+    size_t pos = 0;
+    size_t remaining = max_length;
+    while (remaining > 0 && cur < finish) {
+        // chunk is read directly into the result after the space reserved for its header,
+        // buffer grows only by the header size on each chunk
+        res.resize(pos + timestamped_chunk_header_size + remaining);
+        char* header = std::addressof(res.front()) + pos;
+        char* data = header + timestamped_chunk_header_size;
+        auto wait = static_cast<uint32_t>(finish - cur);
+        uint32_t read = conn.read_available({data, remaining}, wait);
+        auto mono = std::chrono::steady_clock::now().time_since_epoch();
+        auto real = std::chrono::system_clock::now().time_since_epoch();
+        if (0 == read) {
+            break;
+        }
+        size_t len = filter.apply({data, read});
+        if (len > 0) {
+            write_le(header, nanos(mono), 8);
+            write_le(header + 8, nanos(real), 8);
+            write_le(header + 16, len, 4);
+            pos += timestamped_chunk_header_size + len;
+        }
+        remaining -= read;
+        cur = sl::utils::current_time_millis_steady();
+    }
+    res.resize(pos);
+    return res;
+}
+
+} // namespace
+}
+
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   timestamped_read.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 01:10 PM
+ */
+
+#ifndef WILTON_SERIAL_TIMESTAMPED_READ_HPP
+#define WILTON_SERIAL_TIMESTAMPED_READ_HPP
+
+#include <cstdint>
+#include <string>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+
+#include "connection.hpp"
+
+namespace wilton {
+namespace serial {
+
+/**
+ * Byte-level filters applied to the received data in place
+ */
+class read_filter {
+public:
+    // drop zero bytes
+    bool strip_nul = false;
+    // clear the high bit of each byte, for 7-bit data received in 8-bit mode
+    bool mask_parity = false;
+
+    /**
+     * Filters the specified data in place
+     *
+     * @param data data to filter
+     * @return length of the filtered data
+     */
+    size_t apply(sl::io::span<char> data) const {
+        if (!strip_nul && !mask_parity) {
+            return data.size();
+        }
+        size_t len = 0;
+        for (size_t i = 0; i < data.size(); i++) {
+            char ch = data.data()[i];
+            if (mask_parity) {
+                ch = static_cast<char>(ch & 0x7f);
+            }
+            if (strip_nul && '\0' == ch) {
+                continue;
+            }
+            data.data()[len] = ch;
+            len += 1;
+        }
+        return len;
+    }
+};
+
+/**
+ * Size of the header preceding each chunk in the result of `read_timestamped`:
+ * monotonic time nanos (uint64), realtime nanos since epoch (uint64)
+ * and data length (uint32), all little-endian
+ */
+const size_t timestamped_chunk_header_size = 20;
+
+/**
+ * Reads the data chunk by chunk, each chunk is tagged with the monotonic and realtime
+ * timestamps captured as soon as the read call returns; filters are applied
+ * to the received data in the same pass
+ *
+ * @param conn connection
+ * @param max_length max number of bytes to read from the port, before filtering
+ * @param timeout_millis max time to wait for the data, connection timeout is used if zero
+ * @param filter filters to apply
+ * @return packed chunks, each chunk is a header followed by the data
+ */
+std::string read_timestamped(connection& conn, uint32_t max_length, uint32_t timeout_millis,
+        const read_filter& filter);
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_TIMESTAMPED_READ_HPP */
+
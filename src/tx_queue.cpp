@@ -0,0 +1,128 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   tx_queue.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 02:08 PM
+ */
+
+#include "tx_queue.hpp"
+
+#include "staticlib/support.hpp"
+
+#include "wilton/support/exception.hpp"
+
+namespace wilton {
+namespace serial {
+
+tx_queue::tx_queue(tx_writer_fun writer, uint32_t window_micros, uint32_t max_batch_bytes) :
+writer(std::move(writer)),
+window(window_micros),
+max_batch_bytes(max_batch_bytes) {
+    pending.reserve(max_batch_bytes);
+    flusher = std::thread([this] {
+        run();
+    });
+}
+
+tx_queue::~tx_queue() STATICLIB_NOEXCEPT {
+    {
+        std::lock_guard<std::mutex> guard{mutex};
+        stopping = true;
+    }
+    cv.notify_one();
+    flusher.join();
+    try {
+        std::lock_guard<std::mutex> guard{mutex};
+        flush_locked();
+    } catch (const std::exception&) {
+        // ignore, port is closing
+    }
+}
+
+uint32_t tx_queue::write(sl::io::span<const char> data) {
+    std::lock_guard<std::mutex> guard{mutex};
+    if (!bg_error.empty()) {
+        auto err = std::move(bg_error);
+        bg_error = std::string();
+        throw support::exception(TRACEMSG(err));
+    }
+    if (!pending.empty() && pending.length() + data.size() > max_batch_bytes) {
+        flush_locked();
+    }
+    if (pending.empty()) {
+        first_queued = std::chrono::steady_clock::now();
+    }
+    pending.append(data.data(), data.size());
+    if (pending.length() >= max_batch_bytes) {
+        flush_locked();
+    } else {
+        cv.notify_one();
+    }
+    return static_cast<uint32_t>(data.size());
+}
+
+void tx_queue::flush() {
+    std::lock_guard<std::mutex> guard{mutex};
+    if (!bg_error.empty()) {
+        auto err = std::move(bg_error);
+        bg_error = std::string();
+        throw support::exception(TRACEMSG(err));
+    }
+    flush_locked();
+}
+
+void tx_queue::flush_locked() {
+    if (pending.empty()) {
+        return;
+    }
+    size_t len = pending.length();
+    uint32_t written = writer({pending.data(), len});
+    if (written < len) {
+        pending.clear();
+        throw support::exception(TRACEMSG(
+                "Serial queued write timeout, bytes to write: [" + sl::support::to_string(len) + "],"
+                " bytes written: [" + sl::support::to_string(written) + "]"));
+    }
+    pending.clear();
+}
+
+void tx_queue::run() STATICLIB_NOEXCEPT {
+    std::unique_lock<std::mutex> guard{mutex};
+    while (!stopping) {
+        if (pending.empty()) {
+            cv.wait(guard);
+            continue;
+        }
+        auto deadline = first_queued + window;
+        auto flushed = cv.wait_until(guard, deadline, [this] {
+            return stopping || pending.empty();
+        });
+        if (!flushed) {
+            try {
+                flush_locked();
+            } catch (const std::exception& e) {
+                bg_error = e.what();
+            }
+        }
+    }
+}
+
+} // namespace
+}
+
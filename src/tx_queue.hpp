@@ -0,0 +1,108 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   tx_queue.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 02:05 PM
+ */
+
+#ifndef WILTON_SERIAL_TX_QUEUE_HPP
+#define WILTON_SERIAL_TX_QUEUE_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+
+namespace wilton {
+namespace serial {
+
+/**
+ * Function that writes the data to the port, returns the number of bytes written
+ */
+typedef std::function<uint32_t(sl::io::span<const char>)> tx_writer_fun;
+
+/**
+ * Coalescing transmit queue, small writes issued within the time window
+ * are gathered and passed to the port as a single write; queued data
+ * is written by the background thread when the window expires
+ * or immediately when the batch size limit is reached
+ */
+class tx_queue {
+    tx_writer_fun writer;
+    std::chrono::microseconds window;
+    size_t max_batch_bytes;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::string pending;
+    std::chrono::steady_clock::time_point first_queued;
+    // error from the background write, reported on the next call
+    std::string bg_error;
+    bool stopping = false;
+    std::thread flusher;
+
+public:
+    /**
+     * Constructor, starts background thread
+     *
+     * @param writer function writing the data to the port, must outlive the queue
+     * @param window_micros max time the data can stay in the queue
+     * @param max_batch_bytes queue is written immediately when this size is reached
+     */
+    tx_queue(tx_writer_fun writer, uint32_t window_micros, uint32_t max_batch_bytes);
+
+    /**
+     * Writes the remaining queued data and stops the background thread
+     */
+    ~tx_queue() STATICLIB_NOEXCEPT;
+
+    tx_queue(const tx_queue&) = delete;
+
+    tx_queue& operator=(const tx_queue&) = delete;
+
+    /**
+     * Adds the data to the queue
+     *
+     * @param data data to write
+     * @return number of bytes queued
+     */
+    uint32_t write(sl::io::span<const char> data);
+
+    /**
+     * Writes all the queued data to the port
+     */
+    void flush();
+
+private:
+    void flush_locked();
+
+    void run() STATICLIB_NOEXCEPT;
+};
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_TX_QUEUE_HPP */
+
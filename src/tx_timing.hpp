@@ -0,0 +1,74 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   tx_timing.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 02:40 PM
+ */
+
+#ifndef WILTON_SERIAL_TX_TIMING_HPP
+#define WILTON_SERIAL_TX_TIMING_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "serial_config.hpp"
+
+namespace wilton {
+namespace serial {
+
+/**
+ * Time required to transmit the specified number of bytes
+ * with the configured line settings
+ *
+ * @param conf serial config
+ * @param bytes_count number of bytes
+ * @return time on the wire
+ */
+inline std::chrono::microseconds transmit_time(const serial_config& conf, uint64_t bytes_count) {
+    if (0 == conf.baud_rate) {
+        return std::chrono::microseconds(0);
+    }
+    // start bit, data bits, parity bit, stop bits
+    uint64_t bits = 1 + conf.byte_size + (parity_type::none != conf.parity ? 1 : 0) + conf.stop_bits_count;
+    return std::chrono::microseconds(bytes_count * bits * 1000000 / conf.baud_rate);
+}
+
+/**
+ * Sleeps until the specified moment, the last part of the wait
+ * is spinning to not depend on the scheduler wake up latency
+ *
+ * @param deadline moment to wake up at
+ */
+inline void sleep_until_precise(std::chrono::steady_clock::time_point deadline) {
+    const auto spin = std::chrono::microseconds(200);
+    auto now = std::chrono::steady_clock::now();
+    if (deadline - now > spin) {
+        std::this_thread::sleep_until(deadline - spin);
+    }
+    while (std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_TX_TIMING_HPP */
+
@@ -23,35 +23,312 @@
 
 #include "wilton/wilton_serial.h"
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "staticlib/config.hpp"
 
+#include "wilton/wilton.h"
+#include "wilton/wilton_logging.h"
+
 #include "wilton/support/alloc.hpp"
 #include "wilton/support/buffer.hpp"
 #include "wilton/support/logging.hpp"
 #include "wilton/support/misc.hpp"
 
+#include "buffer_pool.hpp"
 #include "connection.hpp"
+#include "fanout.hpp"
+#include "pattern_watcher.hpp"
+#include "poll_scheduler.hpp"
+#include "read_many.hpp"
+#include "probes.hpp"
+#include "file_transfer.hpp"
+#include "frame_parser.hpp"
+#include "hex_codec.hpp"
+#include "line_reader.hpp"
+#include "nmea.hpp"
+#include "port_scanner.hpp"
+#include "profile_registry.hpp"
 #include "serial_config.hpp"
+#include "shm_ring.hpp"
+#include "timestamped_read.hpp"
+#include "xmodem.hpp"
 
 namespace { // anonymous
 
 const std::string logger = std::string("wilton.Serial");
 
+// larger read buffers are not kept by the pool
+const size_t read_pool_max_buffer_size = 65536;
+
+// debug messages with the data are formatted only when they are going to be written
+bool debug_enabled() {
+    static const std::string level = std::string("DEBUG");
+    int res = 0;
+    char* err = wilton_logger_is_level_enabled(logger.c_str(), static_cast<int>(logger.length()),
+            level.c_str(), static_cast<int>(level.length()), std::addressof(res));
+    if (nullptr != err) {
+        wilton_free(err);
+        return false;
+    }
+    return 0 != res;
+}
+
+wilton::serial::xmodem_options make_xmodem_options(const char* protocol, int protocol_len,
+        int retries, int timeout_millis) {
+    auto opts = wilton::serial::xmodem_options();
+    opts.protocol = wilton::serial::make_xmodem_protocol(std::string(protocol, static_cast<uint16_t>(protocol_len)));
+    opts.retries = static_cast<uint32_t>(retries);
+    opts.timeout_millis = static_cast<uint32_t>(timeout_millis);
+    return opts;
+}
+
+wilton::serial::xmodem_progress_fun make_xmodem_progress(
+        void (*progress_cb)(void* ctx, long long bytes_done, long long bytes_total), void* progress_ctx) {
+    if (nullptr == progress_cb) {
+        return nullptr;
+    }
+    return [progress_cb, progress_ctx](uint64_t done, uint64_t total) {
+        progress_cb(progress_ctx, static_cast<long long>(done), static_cast<long long>(total));
+    };
+}
+
+// kind of the direct call to the connection
+enum class direct_io {
+    read,
+    write,
+    control
+};
+
+// user of the connection that reads it in background,
+// subscribers are tracked by the fan-out itself
+enum class background_owner {
+    none,
+    subscribers,
+    poller,
+    ring,
+    watcher
+};
+
+std::string describe_owner(background_owner owner) {
+    switch (owner) {
+    case background_owner::subscribers: return "active subscriptions";
+    case background_owner::poller: return "poll scheduler";
+    case background_owner::ring: return "shared ring";
+    case background_owner::watcher: return "pattern watcher";
+    default: return "none";
+    }
+}
+
 } // namespace
 
 struct wilton_Serial {
 private:
     wilton::serial::connection ser;
+    wilton::serial::buffer_pool pool;
+    // serializes the calls to the connection, held by direct calls
+    // and by background port reads
+    std::mutex io_mutex;
+    // guarded by io_mutex
+    background_owner owner = background_owner::none;
+    // created on first subscription
+    std::mutex fan_mutex;
+    std::shared_ptr<wilton::serial::fanout> fan;
+    std::mutex poll_mutex;
+    std::unique_ptr<wilton::serial::poll_scheduler> poller;
+    std::mutex watch_mutex;
+    std::unique_ptr<wilton::serial::pattern_watcher> watcher;
+    std::mutex shm_mutex;
+    std::unique_ptr<wilton::serial::shm_ring> ring;
 
 public:
     wilton_Serial(wilton::serial::connection&& ser) :
-    ser(std::move(ser)) { }
+    ser(std::move(ser)),
+    pool(this->ser.config().read_pool_size, read_pool_max_buffer_size) { }
+
+    ~wilton_Serial() STATICLIB_NOEXCEPT {
+        poll_stop();
+        shm_stop();
+        std::lock_guard<std::mutex> guard{fan_mutex};
+        if (nullptr != fan.get()) {
+            fan->close();
+        }
+    }
 
     wilton::serial::connection& impl() {
         return ser;
     }
+
+    wilton::serial::buffer_pool& read_pool() {
+        return pool;
+    }
+
+    bool wait_modem_change(const std::vector<wilton::serial::modem_line>& lines, uint32_t timeout_millis) {
+        // I/O mutex is taken for each poll only, the wait must not stall background reads
+        return ser.wait_modem_change(lines, timeout_millis, io_mutex);
+    }
+
+    /**
+     * Locks the connection for the direct call, throws if the port
+     * is read in background
+     *
+     * @param kind kind of the call
+     * @return lock to hold for the duration of the call
+     */
+    std::unique_lock<std::mutex> direct_access(direct_io kind) {
+        std::unique_lock<std::mutex> guard{io_mutex};
+        if (direct_io::read == kind && background_owner::none != owner) throw wilton::support::exception(TRACEMSG(
+                "Direct reads are not allowed while the port is used by: [" + describe_owner(owner) + "]"));
+        // watcher only reads the port when waited for, requests can be sent while it is active
+        if (direct_io::write == kind && background_owner::none != owner &&
+                background_owner::watcher != owner) throw wilton::support::exception(TRACEMSG(
+                "Direct writes are not allowed while the port is used by: [" + describe_owner(owner) + "]"));
+        if (direct_io::read == kind && fanout_active()) throw wilton::support::exception(TRACEMSG(
+                "Direct reads are not allowed while there are active subscriptions"));
+        return guard;
+    }
+
+    /**
+     * Locks the connection for starting the background reader,
+     * throws if the port is already read by the reader of another kind
+     *
+     * @param requested kind of the reader to start
+     * @return lock to hold until the reader is registered
+     */
+    std::unique_lock<std::mutex> background_access(background_owner requested) {
+        std::unique_lock<std::mutex> guard{io_mutex};
+        if (background_owner::none != owner) throw wilton::support::exception(TRACEMSG(
+                "Serial port is already used by: [" + describe_owner(owner) + "],"
+                " requested: [" + describe_owner(requested) + "]"));
+        if (background_owner::subscribers != requested && fanout_active()) throw wilton::support::exception(TRACEMSG(
+                "Serial port is already used by: [" + describe_owner(background_owner::subscribers) + "],"
+                " requested: [" + describe_owner(requested) + "]"));
+        return guard;
+    }
+
+    std::shared_ptr<wilton::serial::fanout> fanout() {
+        std::lock_guard<std::mutex> guard{fan_mutex};
+        if (nullptr == fan.get()) {
+            fan = std::make_shared<wilton::serial::fanout>(ser, io_mutex, ser.config().fanout_buffer_size);
+        }
+        return fan;
+    }
+
+    void poll_start(const sl::json::value& conf) {
+        auto io_guard = background_access(background_owner::poller);
+        std::lock_guard<std::mutex> guard{poll_mutex};
+        poller.reset(new wilton::serial::poll_scheduler(ser, io_mutex, conf));
+        owner = background_owner::poller;
+    }
+
+    sl::json::value poll_results() {
+        std::lock_guard<std::mutex> guard{poll_mutex};
+        if (nullptr == poller.get()) throw wilton::support::exception(TRACEMSG(
+                "Poll scheduler is not running"));
+        return poller->results();
+    }
+
+    void poll_stop() STATICLIB_NOEXCEPT {
+        {
+            // polling thread takes io_mutex, it must not be held here
+            std::lock_guard<std::mutex> guard{poll_mutex};
+            poller.reset();
+        }
+        std::lock_guard<std::mutex> io_guard{io_mutex};
+        if (background_owner::poller == owner) {
+            owner = background_owner::none;
+        }
+    }
+
+    void watch_start(const sl::json::value& conf) {
+        // watch_mutex is taken before io_mutex, the same order as in watch_wait
+        std::lock_guard<std::mutex> guard{watch_mutex};
+        auto io_guard = background_access(background_owner::watcher);
+        watcher.reset(new wilton::serial::pattern_watcher(ser, conf));
+        owner = background_owner::watcher;
+    }
+
+    sl::json::value watch_wait(uint32_t max_matches, uint32_t timeout_millis) {
+        std::lock_guard<std::mutex> guard{watch_mutex};
+        if (nullptr == watcher.get()) throw wilton::support::exception(TRACEMSG(
+                "Pattern watcher is not active"));
+        // watcher is the owner, direct reads are rejected
+        std::lock_guard<std::mutex> io_guard{io_mutex};
+        return watcher->wait(max_matches, timeout_millis);
+    }
+
+    void watch_stop() STATICLIB_NOEXCEPT {
+        std::lock_guard<std::mutex> guard{watch_mutex};
+        watcher.reset();
+        std::lock_guard<std::mutex> io_guard{io_mutex};
+        if (background_owner::watcher == owner) {
+            owner = background_owner::none;
+        }
+    }
+
+    sl::json::value shm_start(const sl::json::value& conf) {
+        auto io_guard = background_access(background_owner::ring);
+        std::lock_guard<std::mutex> guard{shm_mutex};
+        ring.reset(new wilton::serial::shm_ring(ser, io_mutex, conf));
+        owner = background_owner::ring;
+        return ring->info();
+    }
+
+    void shm_advance(uint64_t length, uint32_t timeout_millis, uint64_t& read_pos, uint64_t& write_pos) {
+        std::lock_guard<std::mutex> guard{shm_mutex};
+        if (nullptr == ring.get()) throw wilton::support::exception(TRACEMSG(
+                "Shared ring is not active"));
+        ring->advance(length, timeout_millis, read_pos, write_pos);
+    }
+
+    void shm_stop() STATICLIB_NOEXCEPT {
+        {
+            // receiving thread takes io_mutex, it must not be held here
+            std::lock_guard<std::mutex> guard{shm_mutex};
+            ring.reset();
+        }
+        std::lock_guard<std::mutex> io_guard{io_mutex};
+        if (background_owner::ring == owner) {
+            owner = background_owner::none;
+        }
+    }
+
+private:
+    bool fanout_active() {
+        std::lock_guard<std::mutex> guard{fan_mutex};
+        return nullptr != fan.get() && fan->has_subscribers();
+    }
+};
+
+struct wilton_SerialSubscription {
+private:
+    std::shared_ptr<wilton::serial::fanout> fan;
+    uint32_t id;
+
+public:
+    wilton_SerialSubscription(std::shared_ptr<wilton::serial::fanout> fan, uint32_t id) :
+    fan(std::move(fan)),
+    id(id) { }
+
+    ~wilton_SerialSubscription() STATICLIB_NOEXCEPT {
+        try {
+            fan->unsubscribe(id);
+        } catch (...) {
+            // ignore
+        }
+    }
+
+    wilton::serial::fanout& impl() {
+        return *fan;
+    }
+
+    uint32_t subscriber_id() {
+        return id;
+    }
 };
 
 char* wilton_Serial_open(
@@ -69,6 +346,37 @@ char* wilton_Serial_open(
                 " timeout: [" + sl::support::to_string(sconf.timeout_millis) + "] ...");
         auto ser = wilton::serial::connection(std::move(sconf));
         wilton_Serial* ser_ptr = new wilton_Serial(std::move(ser));
+        WILTON_SERIAL_PROBE1(api_open, ser_ptr);
+        wilton::support::log_debug(logger, "Connection opened, handle: [" + wilton::support::strhandle(ser_ptr) + "]");
+        *ser_out = ser_ptr;
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_open_profile(
+        wilton_Serial** ser_out,
+        const char* profile,
+        int profile_len,
+        const char* port,
+        int port_len) /* noexcept */ {
+    if (nullptr == ser_out) return wilton::support::alloc_copy(TRACEMSG("Null 'ser_out' parameter specified"));
+    if (nullptr == profile) return wilton::support::alloc_copy(TRACEMSG("Null 'profile' parameter specified"));
+    if (!sl::support::is_uint16_positive(profile_len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'profile_len' parameter specified: [" + sl::support::to_string(profile_len) + "]"));
+    if (nullptr == port && 0 != port_len) return wilton::support::alloc_copy(TRACEMSG("Null 'port' parameter specified"));
+    if (!sl::support::is_uint16(port_len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'port_len' parameter specified: [" + sl::support::to_string(port_len) + "]"));
+    try {
+        auto profile_str = std::string(profile, static_cast<uint16_t>(profile_len));
+        auto port_str = nullptr != port ? std::string(port, static_cast<uint16_t>(port_len)) : std::string();
+        auto sconf = wilton::serial::profile_config(profile_str, port_str);
+        wilton::support::log_debug(logger, "Opening serial connection, profile: [" + profile_str + "]," +
+                " port: [" + sconf.port + "] ...");
+        auto ser = wilton::serial::connection(std::move(sconf));
+        wilton_Serial* ser_ptr = new wilton_Serial(std::move(ser));
+        WILTON_SERIAL_PROBE1(api_open, ser_ptr);
         wilton::support::log_debug(logger, "Connection opened, handle: [" + wilton::support::strhandle(ser_ptr) + "]");
         *ser_out = ser_ptr;
         return nullptr;
@@ -77,6 +385,46 @@ char* wilton_Serial_open(
     }
 }
 
+char* wilton_Serial_register_profile(
+        const char* name,
+        int name_len,
+        const char* conf,
+        int conf_len) /* noexcept */ {
+    if (nullptr == name) return wilton::support::alloc_copy(TRACEMSG("Null 'name' parameter specified"));
+    if (!sl::support::is_uint16_positive(name_len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'name_len' parameter specified: [" + sl::support::to_string(name_len) + "]"));
+    if (nullptr == conf) return wilton::support::alloc_copy(TRACEMSG("Null 'conf' parameter specified"));
+    if (!sl::support::is_uint16_positive(conf_len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'conf_len' parameter specified: [" + sl::support::to_string(conf_len) + "]"));
+    try {
+        auto name_str = std::string(name, static_cast<uint16_t>(name_len));
+        auto conf_json = sl::json::load({conf, conf_len});
+        wilton::support::log_debug(logger, "Registering serial profile, name: [" + name_str + "]," +
+                " config: [" + conf_json.dumps() + "] ...");
+        wilton::serial::register_profile(name_str, conf_json);
+        wilton::support::log_debug(logger, "Profile registered");
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_unregister_profile(
+        const char* name,
+        int name_len) /* noexcept */ {
+    if (nullptr == name) return wilton::support::alloc_copy(TRACEMSG("Null 'name' parameter specified"));
+    if (!sl::support::is_uint16_positive(name_len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'name_len' parameter specified: [" + sl::support::to_string(name_len) + "]"));
+    try {
+        auto name_str = std::string(name, static_cast<uint16_t>(name_len));
+        wilton::support::log_debug(logger, "Unregistering serial profile, name: [" + name_str + "]");
+        wilton::serial::unregister_profile(name_str);
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
 char* wilton_Serial_read(
         wilton_Serial* ser,
         int len,
@@ -88,13 +436,93 @@ char* wilton_Serial_read(
     if (nullptr == data_out) return wilton::support::alloc_copy(TRACEMSG("Null 'data_out' parameter specified"));
     if (nullptr == data_len_out) return wilton::support::alloc_copy(TRACEMSG("Null 'data_len_out' parameter specified"));
     try {
-        wilton::support::log_debug(logger, std::string("Reading from serial connection,") +
+        bool debug = debug_enabled();
+        if (debug) {
+            wilton::support::log_debug(logger, std::string("Reading from serial connection,") +
+                    " handle: [" + wilton::support::strhandle(ser) + "]," +
+                    " length: [" + sl::support::to_string(len) + "] ...");
+        }
+        auto pooled = ser->read_pool().acquire(static_cast<uint32_t>(len));
+        auto span = pooled.span();
+        uint64_t probe_start = WILTON_SERIAL_PROBE_NANOS();
+        auto io_guard = ser->direct_access(direct_io::read);
+        uint32_t read = ser->impl().read_into(span);
+        WILTON_SERIAL_PROBE3(api_read, ser, read, WILTON_SERIAL_PROBE_NANOS() - probe_start);
+        if (debug) {
+            wilton::support::log_debug(logger, std::string("Read operation complete,") +
+                    " bytes read: [" + sl::support::to_string(read) + "]," +
+                    " data: [" + sl::io::format_plain_as_hex(std::string(span.data(), read)) + "]");
+        }
+        auto buf = wilton::support::make_array_buffer(span.data(), static_cast<int>(read));
+        *data_out = buf.data();
+        *data_len_out = buf.size_int();
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_read_into(
+        wilton_Serial* ser,
+        char* buf,
+        int cap,
+        int* len_out) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    if (nullptr == buf) return wilton::support::alloc_copy(TRACEMSG("Null 'buf' parameter specified"));
+    if (!sl::support::is_uint32_positive(cap)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'cap' parameter specified: [" + sl::support::to_string(cap) + "]"));
+    if (nullptr == len_out) return wilton::support::alloc_copy(TRACEMSG("Null 'len_out' parameter specified"));
+    try {
+        // this call must not allocate unless debug logging is enabled
+        bool debug = debug_enabled();
+        if (debug) {
+            wilton::support::log_debug(logger, std::string("Reading from serial connection,") +
+                    " handle: [" + wilton::support::strhandle(ser) + "]," +
+                    " length: [" + sl::support::to_string(cap) + "] ...");
+        }
+        uint64_t probe_start = WILTON_SERIAL_PROBE_NANOS();
+        auto io_guard = ser->direct_access(direct_io::read);
+        uint32_t read = ser->impl().read_into({buf, cap});
+        WILTON_SERIAL_PROBE3(api_read, ser, read, WILTON_SERIAL_PROBE_NANOS() - probe_start);
+        if (debug) {
+            wilton::support::log_debug(logger, std::string("Read operation complete,") +
+                    " bytes read: [" + sl::support::to_string(read) + "]," +
+                    " data: [" + sl::io::format_plain_as_hex(std::string(buf, read)) + "]");
+        }
+        *len_out = static_cast<int>(read);
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_read_timestamped(
+        wilton_Serial* ser,
+        int len,
+        int timeout_millis,
+        int strip_nul,
+        int mask_parity,
+        char** data_out,
+        int* data_len_out) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    if (!sl::support::is_uint32_positive(len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'len' parameter specified: [" + sl::support::to_string(len) + "]"));
+    if (!sl::support::is_uint32(timeout_millis)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'timeout_millis' parameter specified: [" + sl::support::to_string(timeout_millis) + "]"));
+    if (nullptr == data_out) return wilton::support::alloc_copy(TRACEMSG("Null 'data_out' parameter specified"));
+    if (nullptr == data_len_out) return wilton::support::alloc_copy(TRACEMSG("Null 'data_len_out' parameter specified"));
+    try {
+        wilton::support::log_debug(logger, std::string("Reading timestamped chunks from serial connection,") +
                 " handle: [" + wilton::support::strhandle(ser) + "]," +
                 " length: [" + sl::support::to_string(len) + "] ...");
-        std::string res = ser->impl().read(static_cast<uint32_t>(len));
+        auto filter = wilton::serial::read_filter();
+        filter.strip_nul = 0 != strip_nul;
+        filter.mask_parity = 0 != mask_parity;
+        auto io_guard = ser->direct_access(direct_io::read);
+        std::string res = wilton::serial::read_timestamped(ser->impl(), static_cast<uint32_t>(len),
+                static_cast<uint32_t>(timeout_millis), filter);
         wilton::support::log_debug(logger, std::string("Read operation complete,") +
-                " bytes read: [" + sl::support::to_string(res.length()) + "]," +
-                " data: [" + sl::io::format_plain_as_hex(res) + "]");
+                " result length: [" + sl::support::to_string(res.length()) + "]");
         auto buf = wilton::support::make_string_buffer(res);
         *data_out = buf.data();
         *data_len_out = buf.size_int();
@@ -114,6 +542,7 @@ char* wilton_Serial_readline(
     try {
         wilton::support::log_debug(logger, std::string("Reading a line from serial connection,") +
                 " handle: [" + wilton::support::strhandle(ser) + "] ...");
+        auto io_guard = ser->direct_access(direct_io::read);
         std::string res = ser->impl().read_line();
         wilton::support::log_debug(logger, std::string("Read operation complete,") +
                 " bytes read: [" + sl::support::to_string(res.length()) + "]," +
@@ -128,6 +557,160 @@ char* wilton_Serial_readline(
 
 }
 
+char* wilton_Serial_readlines(
+        wilton_Serial* ser,
+        int max_lines,
+        int timeout_millis,
+        char** lines_json_out,
+        int* lines_json_len_out) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    if (!sl::support::is_uint32_positive(max_lines)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'max_lines' parameter specified: [" + sl::support::to_string(max_lines) + "]"));
+    if (!sl::support::is_uint32(timeout_millis)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'timeout_millis' parameter specified: [" + sl::support::to_string(timeout_millis) + "]"));
+    if (nullptr == lines_json_out) return wilton::support::alloc_copy(TRACEMSG("Null 'lines_json_out' parameter specified"));
+    if (nullptr == lines_json_len_out) return wilton::support::alloc_copy(TRACEMSG("Null 'lines_json_len_out' parameter specified"));
+    try {
+        wilton::support::log_debug(logger, std::string("Reading lines from serial connection,") +
+                " handle: [" + wilton::support::strhandle(ser) + "]," +
+                " max lines: [" + sl::support::to_string(max_lines) + "] ...");
+        auto io_guard = ser->direct_access(direct_io::read);
+        auto lines = wilton::serial::read_lines(ser->impl(), static_cast<uint32_t>(max_lines),
+                static_cast<uint32_t>(timeout_millis));
+        wilton::support::log_debug(logger, std::string("Read operation complete,") +
+                " lines read: [" + sl::support::to_string(lines.size()) + "]");
+        // lines are hex-encoded, same as single line reads
+        auto arr = std::vector<sl::json::value>();
+        arr.reserve(lines.size());
+        for (auto& li : lines) {
+            arr.emplace_back(wilton::serial::hex_encode({li.data(), li.length()}));
+        }
+        auto res = sl::json::value(std::move(arr)).dumps();
+        auto buf = wilton::support::make_string_buffer(res);
+        *lines_json_out = buf.data();
+        *lines_json_len_out = buf.size_int();
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_read_nmea(
+        wilton_Serial* ser,
+        int max_sentences,
+        int timeout_millis,
+        char** result_out,
+        int* result_len_out) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    if (!sl::support::is_uint32_positive(max_sentences)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'max_sentences' parameter specified: [" + sl::support::to_string(max_sentences) + "]"));
+    if (!sl::support::is_uint32(timeout_millis)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'timeout_millis' parameter specified: [" + sl::support::to_string(timeout_millis) + "]"));
+    if (nullptr == result_out) return wilton::support::alloc_copy(TRACEMSG("Null 'result_out' parameter specified"));
+    if (nullptr == result_len_out) return wilton::support::alloc_copy(TRACEMSG("Null 'result_len_out' parameter specified"));
+    try {
+        wilton::support::log_debug(logger, std::string("Reading NMEA sentences from serial connection,") +
+                " handle: [" + wilton::support::strhandle(ser) + "]," +
+                " max sentences: [" + sl::support::to_string(max_sentences) + "] ...");
+        auto io_guard = ser->direct_access(direct_io::read);
+        auto res = wilton::serial::read_nmea(ser->impl(), static_cast<uint32_t>(max_sentences),
+                static_cast<uint32_t>(timeout_millis)).dumps();
+        wilton::support::log_debug(logger, std::string("Read operation complete,") +
+                " result length: [" + sl::support::to_string(res.length()) + "]");
+        auto buf = wilton::support::make_string_buffer(res);
+        *result_out = buf.data();
+        *result_len_out = buf.size_int();
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_read_frames(
+        wilton_Serial* ser,
+        const char* framing,
+        int framing_len,
+        int max_frames,
+        int timeout_millis,
+        char** result_out,
+        int* result_len_out) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    if (nullptr == framing) return wilton::support::alloc_copy(TRACEMSG("Null 'framing' parameter specified"));
+    if (!sl::support::is_uint16_positive(framing_len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'framing_len' parameter specified: [" + sl::support::to_string(framing_len) + "]"));
+    if (!sl::support::is_uint32_positive(max_frames)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'max_frames' parameter specified: [" + sl::support::to_string(max_frames) + "]"));
+    if (!sl::support::is_uint32(timeout_millis)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'timeout_millis' parameter specified: [" + sl::support::to_string(timeout_millis) + "]"));
+    if (nullptr == result_out) return wilton::support::alloc_copy(TRACEMSG("Null 'result_out' parameter specified"));
+    if (nullptr == result_len_out) return wilton::support::alloc_copy(TRACEMSG("Null 'result_len_out' parameter specified"));
+    try {
+        auto framing_str = std::string(framing, static_cast<uint16_t>(framing_len));
+        wilton::support::log_debug(logger, std::string("Reading frames from serial connection,") +
+                " handle: [" + wilton::support::strhandle(ser) + "]," +
+                " framing: [" + framing_str + "]," +
+                " max frames: [" + sl::support::to_string(max_frames) + "] ...");
+        auto io_guard = ser->direct_access(direct_io::read);
+        auto res = wilton::serial::read_frames(ser->impl(), framing_str, static_cast<uint32_t>(max_frames),
+                static_cast<uint32_t>(timeout_millis)).dumps();
+        wilton::support::log_debug(logger, std::string("Read operation complete,") +
+                " result length: [" + sl::support::to_string(res.length()) + "]");
+        auto buf = wilton::support::make_string_buffer(res);
+        *result_out = buf.data();
+        *result_len_out = buf.size_int();
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_read_many(
+        wilton_Serial** sers,
+        int sers_count,
+        const long long* keys,
+        int len,
+        int timeout_millis,
+        char** result_out,
+        int* result_len_out) /* noexcept */ {
+    if (nullptr == sers) return wilton::support::alloc_copy(TRACEMSG("Null 'sers' parameter specified"));
+    if (!sl::support::is_uint32_positive(sers_count)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'sers_count' parameter specified: [" + sl::support::to_string(sers_count) + "]"));
+    if (!sl::support::is_uint32_positive(len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'len' parameter specified: [" + sl::support::to_string(len) + "]"));
+    if (!sl::support::is_uint32(timeout_millis)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'timeout_millis' parameter specified: [" + sl::support::to_string(timeout_millis) + "]"));
+    if (nullptr == result_out) return wilton::support::alloc_copy(TRACEMSG("Null 'result_out' parameter specified"));
+    if (nullptr == result_len_out) return wilton::support::alloc_copy(TRACEMSG("Null 'result_len_out' parameter specified"));
+    try {
+        auto conns = std::vector<wilton::serial::connection*>();
+        auto keys_str = std::vector<std::string>();
+        for (int i = 0; i < sers_count; i++) {
+            if (nullptr == sers[i]) throw wilton::support::exception(TRACEMSG(
+                    "Null serial handle specified, index: [" + sl::support::to_string(i) + "]"));
+            conns.push_back(std::addressof(sers[i]->impl()));
+            if (nullptr != keys) {
+                keys_str.push_back(sl::support::to_string(keys[i]));
+            }
+        }
+        // locked in address order, the same handle may be specified twice
+        auto locked = std::vector<wilton_Serial*>(sers, sers + sers_count);
+        std::sort(locked.begin(), locked.end());
+        locked.erase(std::unique(locked.begin(), locked.end()), locked.end());
+        auto io_guards = std::vector<std::unique_lock<std::mutex>>();
+        for (wilton_Serial* ptr : locked) {
+            io_guards.emplace_back(ptr->direct_access(direct_io::read));
+        }
+        auto res = wilton::serial::read_many(conns, keys_str, static_cast<uint32_t>(len),
+                static_cast<uint32_t>(timeout_millis)).dumps();
+        auto buf = wilton::support::make_string_buffer(res);
+        *result_out = buf.data();
+        *result_len_out = buf.size_int();
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
 char* wilton_Serial_write(
         wilton_Serial* ser,
         const char* data,
@@ -138,17 +721,15 @@ char* wilton_Serial_write(
     if (!sl::support::is_uint32_positive(data_len)) return wilton::support::alloc_copy(TRACEMSG(
             "Invalid 'data_len' parameter specified: [" + sl::support::to_string(data_len) + "]"));
     try {
-        auto data_src = sl::io::array_source(data, data_len);
-        auto hex_sink = sl::io::string_sink();
-        {
-            auto sink = sl::io::make_hex_sink(hex_sink);
-            sl::io::copy_all(data_src, sink);
-        }
+        auto hex = wilton::serial::hex_encode({data, data_len});
         wilton::support::log_debug(logger, std::string("Writing data to serial connection,") +
                 " handle: [" + wilton::support::strhandle(ser) + "]," +
-                " data: [" + sl::io::format_hex(hex_sink.get_string()) +  "],"
+                " data: [" + sl::io::format_hex(hex) +  "],"
                 " data_len: [" + sl::support::to_string(data_len) +  "] ...");
+        uint64_t probe_start = WILTON_SERIAL_PROBE_NANOS();
+        auto io_guard = ser->direct_access(direct_io::write);
         uint32_t written = ser->impl().write({data, data_len});
+        WILTON_SERIAL_PROBE3(api_write, ser, written, WILTON_SERIAL_PROBE_NANOS() - probe_start);
         wilton::support::log_debug(logger, std::string("Write operation complete,") +
                 " bytes written: [" + sl::support::to_string(written) + "]");
         *len_written_out = static_cast<int>(written);
@@ -158,11 +739,343 @@ char* wilton_Serial_write(
     }
 }
 
+char* wilton_Serial_write_drain(
+        wilton_Serial* ser,
+        const char* data,
+        int data_len,
+        int* len_written_out) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    if (nullptr == data) return wilton::support::alloc_copy(TRACEMSG("Null 'data' parameter specified"));
+    if (!sl::support::is_uint32_positive(data_len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'data_len' parameter specified: [" + sl::support::to_string(data_len) + "]"));
+    if (nullptr == len_written_out) return wilton::support::alloc_copy(TRACEMSG("Null 'len_written_out' parameter specified"));
+    try {
+        wilton::support::log_debug(logger, std::string("Writing data to serial connection and draining,") +
+                " handle: [" + wilton::support::strhandle(ser) + "]," +
+                " data_len: [" + sl::support::to_string(data_len) +  "] ...");
+        uint64_t probe_start = WILTON_SERIAL_PROBE_NANOS();
+        auto io_guard = ser->direct_access(direct_io::write);
+        uint32_t written = ser->impl().write_drain({data, data_len});
+        WILTON_SERIAL_PROBE3(api_write, ser, written, WILTON_SERIAL_PROBE_NANOS() - probe_start);
+        wilton::support::log_debug(logger, std::string("Write operation complete,") +
+                " bytes written: [" + sl::support::to_string(written) + "]");
+        *len_written_out = static_cast<int>(written);
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_flush(
+        wilton_Serial* ser) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    try {
+        auto io_guard = ser->direct_access(direct_io::write);
+        ser->impl().flush();
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_drain(
+        wilton_Serial* ser) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    try {
+        wilton::support::log_debug(logger, "Draining serial connection, handle: [" + wilton::support::strhandle(ser) + "] ...");
+        auto io_guard = ser->direct_access(direct_io::write);
+        ser->impl().drain();
+        wilton::support::log_debug(logger, "Drain complete");
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_send_file(
+        wilton_Serial* ser,
+        const char* path,
+        int path_len,
+        int chunk_size,
+        int chunk_delay_millis,
+        int max_bytes,
+        int* len_written_out) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    if (nullptr == path) return wilton::support::alloc_copy(TRACEMSG("Null 'path' parameter specified"));
+    if (!sl::support::is_uint16_positive(path_len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'path_len' parameter specified: [" + sl::support::to_string(path_len) + "]"));
+    if (!sl::support::is_uint32_positive(chunk_size)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'chunk_size' parameter specified: [" + sl::support::to_string(chunk_size) + "]"));
+    if (!sl::support::is_uint32(chunk_delay_millis)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'chunk_delay_millis' parameter specified: [" + sl::support::to_string(chunk_delay_millis) + "]"));
+    if (!sl::support::is_uint32(max_bytes)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'max_bytes' parameter specified: [" + sl::support::to_string(max_bytes) + "]"));
+    if (nullptr == len_written_out) return wilton::support::alloc_copy(TRACEMSG("Null 'len_written_out' parameter specified"));
+    try {
+        auto path_str = std::string(path, static_cast<uint16_t>(path_len));
+        wilton::support::log_debug(logger, std::string("Sending file to serial connection,") +
+                " handle: [" + wilton::support::strhandle(ser) + "]," +
+                " path: [" + path_str + "]," +
+                " chunk size: [" + sl::support::to_string(chunk_size) + "] ...");
+        auto io_guard = ser->direct_access(direct_io::write);
+        uint64_t written = wilton::serial::send_file(ser->impl(), path_str,
+                static_cast<uint32_t>(chunk_size), static_cast<uint32_t>(chunk_delay_millis),
+                static_cast<uint64_t>(max_bytes));
+        wilton::support::log_debug(logger, std::string("Send file operation complete,") +
+                " bytes written: [" + sl::support::to_string(written) + "]");
+        *len_written_out = static_cast<int>(written);
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_receive_to_file(
+        wilton_Serial* ser,
+        const char* path,
+        int path_len,
+        int chunk_size,
+        int max_bytes,
+        const char* terminator,
+        int terminator_len,
+        int idle_timeout_millis,
+        int* len_read_out) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    if (nullptr == path) return wilton::support::alloc_copy(TRACEMSG("Null 'path' parameter specified"));
+    if (!sl::support::is_uint16_positive(path_len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'path_len' parameter specified: [" + sl::support::to_string(path_len) + "]"));
+    if (!sl::support::is_uint32_positive(chunk_size)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'chunk_size' parameter specified: [" + sl::support::to_string(chunk_size) + "]"));
+    if (!sl::support::is_uint32(max_bytes)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'max_bytes' parameter specified: [" + sl::support::to_string(max_bytes) + "]"));
+    if (nullptr == terminator && 0 != terminator_len) return wilton::support::alloc_copy(TRACEMSG(
+            "Null 'terminator' parameter specified"));
+    if (!sl::support::is_uint16(terminator_len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'terminator_len' parameter specified: [" + sl::support::to_string(terminator_len) + "]"));
+    if (!sl::support::is_uint32(idle_timeout_millis)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'idle_timeout_millis' parameter specified: [" + sl::support::to_string(idle_timeout_millis) + "]"));
+    if (nullptr == len_read_out) return wilton::support::alloc_copy(TRACEMSG("Null 'len_read_out' parameter specified"));
+    try {
+        auto path_str = std::string(path, static_cast<uint16_t>(path_len));
+        auto terminator_str = terminator_len > 0 ?
+                std::string(terminator, static_cast<uint16_t>(terminator_len)) : std::string();
+        wilton::support::log_debug(logger, std::string("Receiving file from serial connection,") +
+                " handle: [" + wilton::support::strhandle(ser) + "]," +
+                " path: [" + path_str + "]," +
+                " chunk size: [" + sl::support::to_string(chunk_size) + "]," +
+                " terminator: [" + sl::io::format_plain_as_hex(terminator_str) + "] ...");
+        auto io_guard = ser->direct_access(direct_io::read);
+        uint64_t read = wilton::serial::receive_to_file(ser->impl(), path_str,
+                static_cast<uint32_t>(chunk_size), static_cast<uint64_t>(max_bytes),
+                terminator_str, static_cast<uint32_t>(idle_timeout_millis));
+        wilton::support::log_debug(logger, std::string("Receive file operation complete,") +
+                " bytes read: [" + sl::support::to_string(read) + "]");
+        *len_read_out = static_cast<int>(read);
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_xmodem_send(
+        wilton_Serial* ser,
+        const char* path,
+        int path_len,
+        const char* protocol,
+        int protocol_len,
+        int retries,
+        int timeout_millis,
+        void (*progress_cb)(void* ctx, long long bytes_done, long long bytes_total),
+        void* progress_ctx,
+        int* len_written_out) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    if (nullptr == path) return wilton::support::alloc_copy(TRACEMSG("Null 'path' parameter specified"));
+    if (!sl::support::is_uint16_positive(path_len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'path_len' parameter specified: [" + sl::support::to_string(path_len) + "]"));
+    if (nullptr == protocol) return wilton::support::alloc_copy(TRACEMSG("Null 'protocol' parameter specified"));
+    if (!sl::support::is_uint16_positive(protocol_len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'protocol_len' parameter specified: [" + sl::support::to_string(protocol_len) + "]"));
+    if (!sl::support::is_uint32_positive(retries)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'retries' parameter specified: [" + sl::support::to_string(retries) + "]"));
+    if (!sl::support::is_uint32_positive(timeout_millis)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'timeout_millis' parameter specified: [" + sl::support::to_string(timeout_millis) + "]"));
+    if (nullptr == len_written_out) return wilton::support::alloc_copy(TRACEMSG("Null 'len_written_out' parameter specified"));
+    try {
+        auto path_str = std::string(path, static_cast<uint16_t>(path_len));
+        auto opts = make_xmodem_options(protocol, protocol_len, retries, timeout_millis);
+        wilton::support::log_debug(logger, std::string("Sending file over XMODEM,") +
+                " handle: [" + wilton::support::strhandle(ser) + "]," +
+                " path: [" + path_str + "]," +
+                " protocol: [" + wilton::serial::stringify_xmodem_protocol(opts.protocol) + "] ...");
+        // receiver replies are read from the port
+        auto io_guard = ser->direct_access(direct_io::read);
+        auto res = wilton::serial::xmodem_send(ser->impl(), path_str, opts,
+                make_xmodem_progress(progress_cb, progress_ctx));
+        wilton::support::log_debug(logger, std::string("XMODEM send operation complete,") +
+                " bytes written: [" + sl::support::to_string(res.bytes_count) + "]");
+        *len_written_out = static_cast<int>(res.bytes_count);
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_xmodem_receive(
+        wilton_Serial* ser,
+        const char* path,
+        int path_len,
+        const char* protocol,
+        int protocol_len,
+        int retries,
+        int timeout_millis,
+        void (*progress_cb)(void* ctx, long long bytes_done, long long bytes_total),
+        void* progress_ctx,
+        char** file_name_out,
+        int* file_name_len_out,
+        int* len_read_out) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    if (nullptr == path) return wilton::support::alloc_copy(TRACEMSG("Null 'path' parameter specified"));
+    if (!sl::support::is_uint16_positive(path_len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'path_len' parameter specified: [" + sl::support::to_string(path_len) + "]"));
+    if (nullptr == protocol) return wilton::support::alloc_copy(TRACEMSG("Null 'protocol' parameter specified"));
+    if (!sl::support::is_uint16_positive(protocol_len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'protocol_len' parameter specified: [" + sl::support::to_string(protocol_len) + "]"));
+    if (!sl::support::is_uint32_positive(retries)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'retries' parameter specified: [" + sl::support::to_string(retries) + "]"));
+    if (!sl::support::is_uint32_positive(timeout_millis)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'timeout_millis' parameter specified: [" + sl::support::to_string(timeout_millis) + "]"));
+    if (nullptr == file_name_out) return wilton::support::alloc_copy(TRACEMSG("Null 'file_name_out' parameter specified"));
+    if (nullptr == file_name_len_out) return wilton::support::alloc_copy(TRACEMSG("Null 'file_name_len_out' parameter specified"));
+    if (nullptr == len_read_out) return wilton::support::alloc_copy(TRACEMSG("Null 'len_read_out' parameter specified"));
+    try {
+        auto path_str = std::string(path, static_cast<uint16_t>(path_len));
+        auto opts = make_xmodem_options(protocol, protocol_len, retries, timeout_millis);
+        wilton::support::log_debug(logger, std::string("Receiving file over XMODEM,") +
+                " handle: [" + wilton::support::strhandle(ser) + "]," +
+                " path: [" + path_str + "]," +
+                " protocol: [" + wilton::serial::stringify_xmodem_protocol(opts.protocol) + "] ...");
+        auto io_guard = ser->direct_access(direct_io::read);
+        auto res = wilton::serial::xmodem_receive(ser->impl(), path_str, opts,
+                make_xmodem_progress(progress_cb, progress_ctx));
+        wilton::support::log_debug(logger, std::string("XMODEM receive operation complete,") +
+                " bytes read: [" + sl::support::to_string(res.bytes_count) + "]," +
+                " file name: [" + res.file_name + "]");
+        auto buf = wilton::support::make_string_buffer(res.file_name);
+        *file_name_out = buf.data();
+        *file_name_len_out = buf.size_int();
+        *len_read_out = static_cast<int>(res.bytes_count);
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_get_modem_lines(
+        wilton_Serial* ser,
+        char** lines_json_out,
+        int* lines_json_len_out) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    if (nullptr == lines_json_out) return wilton::support::alloc_copy(TRACEMSG("Null 'lines_json_out' parameter specified"));
+    if (nullptr == lines_json_len_out) return wilton::support::alloc_copy(TRACEMSG("Null 'lines_json_len_out' parameter specified"));
+    try {
+        auto io_guard = ser->direct_access(direct_io::control);
+        auto res = ser->impl().modem_lines().dumps();
+        auto buf = wilton::support::make_string_buffer(res);
+        *lines_json_out = buf.data();
+        *lines_json_len_out = buf.size_int();
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_set_modem_line(
+        wilton_Serial* ser,
+        const char* line,
+        int line_len,
+        int value) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    if (nullptr == line) return wilton::support::alloc_copy(TRACEMSG("Null 'line' parameter specified"));
+    if (!sl::support::is_uint16_positive(line_len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'line_len' parameter specified: [" + sl::support::to_string(line_len) + "]"));
+    try {
+        auto line_str = std::string(line, static_cast<uint16_t>(line_len));
+        wilton::support::log_debug(logger, "Setting modem line, handle: [" + wilton::support::strhandle(ser) + "]," +
+                " line: [" + line_str + "], value: [" + (0 != value ? "true" : "false") + "]");
+        auto io_guard = ser->direct_access(direct_io::write);
+        ser->impl().set_modem_line(wilton::serial::make_modem_line(line_str), 0 != value);
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_send_break(
+        wilton_Serial* ser,
+        int duration_millis) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    if (!sl::support::is_uint32(duration_millis)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'duration_millis' parameter specified: [" + sl::support::to_string(duration_millis) + "]"));
+    try {
+        wilton::support::log_debug(logger, "Sending break, handle: [" + wilton::support::strhandle(ser) + "]," +
+                " duration: [" + sl::support::to_string(duration_millis) + "] ...");
+        auto io_guard = ser->direct_access(direct_io::write);
+        ser->impl().send_break(static_cast<uint32_t>(duration_millis));
+        wilton::support::log_debug(logger, "Break sent");
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_wait_modem_change(
+        wilton_Serial* ser,
+        const char* lines,
+        int lines_len,
+        int timeout_millis,
+        int* changed_out) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    if (nullptr == lines) return wilton::support::alloc_copy(TRACEMSG("Null 'lines' parameter specified"));
+    if (!sl::support::is_uint16_positive(lines_len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'lines_len' parameter specified: [" + sl::support::to_string(lines_len) + "]"));
+    if (!sl::support::is_uint32(timeout_millis)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'timeout_millis' parameter specified: [" + sl::support::to_string(timeout_millis) + "]"));
+    if (nullptr == changed_out) return wilton::support::alloc_copy(TRACEMSG("Null 'changed_out' parameter specified"));
+    try {
+        auto lines_vec = wilton::serial::make_modem_lines(std::string(lines, static_cast<uint16_t>(lines_len)));
+        bool changed = ser->wait_modem_change(lines_vec, static_cast<uint32_t>(timeout_millis));
+        *changed_out = changed ? 1 : 0;
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_status(
+        wilton_Serial* ser,
+        char** status_json_out,
+        int* status_json_len_out) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    if (nullptr == status_json_out) return wilton::support::alloc_copy(TRACEMSG("Null 'status_json_out' parameter specified"));
+    if (nullptr == status_json_len_out) return wilton::support::alloc_copy(TRACEMSG("Null 'status_json_len_out' parameter specified"));
+    try {
+        auto io_guard = ser->direct_access(direct_io::control);
+        auto res = ser->impl().status().dumps();
+        auto buf = wilton::support::make_string_buffer(res);
+        *status_json_out = buf.data();
+        *status_json_len_out = buf.size_int();
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
 char* wilton_Serial_close(
         wilton_Serial* ser) /* noexcept */ {
     if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
     try {
         wilton::support::log_debug(logger, "Closing serial connection, handle: [" + wilton::support::strhandle(ser) + "] ...");
+        WILTON_SERIAL_PROBE1(api_close, ser);
         delete ser;
         wilton::support::log_debug(logger, "Connection closed");
         return nullptr;
@@ -171,3 +1084,289 @@ char* wilton_Serial_close(
     }
 }
 
+char* wilton_Serial_poll_start(
+        wilton_Serial* ser,
+        const char* conf,
+        int conf_len) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    if (nullptr == conf) return wilton::support::alloc_copy(TRACEMSG("Null 'conf' parameter specified"));
+    if (!sl::support::is_uint32_positive(conf_len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'conf_len' parameter specified: [" + sl::support::to_string(conf_len) + "]"));
+    try {
+        auto conf_json = sl::json::load({conf, conf_len});
+        wilton::support::log_debug(logger, "Starting poll scheduler, handle: [" + wilton::support::strhandle(ser) + "]," +
+                " config: [" + conf_json.dumps() + "] ...");
+        ser->poll_start(conf_json);
+        wilton::support::log_debug(logger, "Poll scheduler started");
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_poll_results(
+        wilton_Serial* ser,
+        char** results_json_out,
+        int* results_json_len_out) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    if (nullptr == results_json_out) return wilton::support::alloc_copy(TRACEMSG("Null 'results_json_out' parameter specified"));
+    if (nullptr == results_json_len_out) return wilton::support::alloc_copy(TRACEMSG("Null 'results_json_len_out' parameter specified"));
+    try {
+        auto res = ser->poll_results().dumps();
+        auto buf = wilton::support::make_string_buffer(res);
+        *results_json_out = buf.data();
+        *results_json_len_out = buf.size_int();
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_poll_stop(
+        wilton_Serial* ser) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    try {
+        wilton::support::log_debug(logger, "Stopping poll scheduler, handle: [" + wilton::support::strhandle(ser) + "] ...");
+        ser->poll_stop();
+        wilton::support::log_debug(logger, "Poll scheduler stopped");
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_watch_start(
+        wilton_Serial* ser,
+        const char* conf,
+        int conf_len) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    if (nullptr == conf) return wilton::support::alloc_copy(TRACEMSG("Null 'conf' parameter specified"));
+    if (!sl::support::is_uint32_positive(conf_len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'conf_len' parameter specified: [" + sl::support::to_string(conf_len) + "]"));
+    try {
+        auto conf_json = sl::json::load({conf, conf_len});
+        wilton::support::log_debug(logger, "Starting pattern watcher, handle: [" + wilton::support::strhandle(ser) + "]," +
+                " config: [" + conf_json.dumps() + "] ...");
+        ser->watch_start(conf_json);
+        wilton::support::log_debug(logger, "Pattern watcher started");
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_watch_wait(
+        wilton_Serial* ser,
+        int max_matches,
+        int timeout_millis,
+        char** result_out,
+        int* result_len_out) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    if (!sl::support::is_uint32_positive(max_matches)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'max_matches' parameter specified: [" + sl::support::to_string(max_matches) + "]"));
+    if (!sl::support::is_uint32(timeout_millis)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'timeout_millis' parameter specified: [" + sl::support::to_string(timeout_millis) + "]"));
+    if (nullptr == result_out) return wilton::support::alloc_copy(TRACEMSG("Null 'result_out' parameter specified"));
+    if (nullptr == result_len_out) return wilton::support::alloc_copy(TRACEMSG("Null 'result_len_out' parameter specified"));
+    try {
+        auto res = ser->watch_wait(static_cast<uint32_t>(max_matches),
+                static_cast<uint32_t>(timeout_millis)).dumps();
+        auto buf = wilton::support::make_string_buffer(res);
+        *result_out = buf.data();
+        *result_len_out = buf.size_int();
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_watch_stop(
+        wilton_Serial* ser) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    try {
+        wilton::support::log_debug(logger, "Stopping pattern watcher, handle: [" + wilton::support::strhandle(ser) + "] ...");
+        ser->watch_stop();
+        wilton::support::log_debug(logger, "Pattern watcher stopped");
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_shm_start(
+        wilton_Serial* ser,
+        const char* conf,
+        int conf_len,
+        char** info_json_out,
+        int* info_json_len_out) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    if (nullptr == conf) return wilton::support::alloc_copy(TRACEMSG("Null 'conf' parameter specified"));
+    if (!sl::support::is_uint32_positive(conf_len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'conf_len' parameter specified: [" + sl::support::to_string(conf_len) + "]"));
+    if (nullptr == info_json_out) return wilton::support::alloc_copy(TRACEMSG("Null 'info_json_out' parameter specified"));
+    if (nullptr == info_json_len_out) return wilton::support::alloc_copy(TRACEMSG("Null 'info_json_len_out' parameter specified"));
+    try {
+        auto conf_json = sl::json::load({conf, conf_len});
+        wilton::support::log_debug(logger, "Starting shared ring, handle: [" + wilton::support::strhandle(ser) + "]," +
+                " config: [" + conf_json.dumps() + "] ...");
+        auto res = ser->shm_start(conf_json).dumps();
+        wilton::support::log_debug(logger, "Shared ring started, info: [" + res + "]");
+        auto buf = wilton::support::make_string_buffer(res);
+        *info_json_out = buf.data();
+        *info_json_len_out = buf.size_int();
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_shm_advance(
+        wilton_Serial* ser,
+        int len,
+        int timeout_millis,
+        long long* read_pos_out,
+        long long* write_pos_out) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    if (!sl::support::is_uint32(len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'len' parameter specified: [" + sl::support::to_string(len) + "]"));
+    if (!sl::support::is_uint32(timeout_millis)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'timeout_millis' parameter specified: [" + sl::support::to_string(timeout_millis) + "]"));
+    if (nullptr == read_pos_out) return wilton::support::alloc_copy(TRACEMSG("Null 'read_pos_out' parameter specified"));
+    if (nullptr == write_pos_out) return wilton::support::alloc_copy(TRACEMSG("Null 'write_pos_out' parameter specified"));
+    try {
+        uint64_t read_pos = 0;
+        uint64_t write_pos = 0;
+        ser->shm_advance(static_cast<uint64_t>(len), static_cast<uint32_t>(timeout_millis), read_pos, write_pos);
+        *read_pos_out = static_cast<long long>(read_pos);
+        *write_pos_out = static_cast<long long>(write_pos);
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_shm_stop(
+        wilton_Serial* ser) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    try {
+        wilton::support::log_debug(logger, "Stopping shared ring, handle: [" + wilton::support::strhandle(ser) + "] ...");
+        ser->shm_stop();
+        wilton::support::log_debug(logger, "Shared ring stopped");
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_subscribe(
+        wilton_Serial* ser,
+        const char* overflow_policy,
+        int overflow_policy_len,
+        wilton_SerialSubscription** sub_out) /* noexcept */ {
+    if (nullptr == ser) return wilton::support::alloc_copy(TRACEMSG("Null 'ser' parameter specified"));
+    if (nullptr == overflow_policy) return wilton::support::alloc_copy(TRACEMSG("Null 'overflow_policy' parameter specified"));
+    if (!sl::support::is_uint16_positive(overflow_policy_len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'overflow_policy_len' parameter specified: [" + sl::support::to_string(overflow_policy_len) + "]"));
+    if (nullptr == sub_out) return wilton::support::alloc_copy(TRACEMSG("Null 'sub_out' parameter specified"));
+    try {
+        auto policy = wilton::serial::make_overflow_policy(std::string(overflow_policy,
+                static_cast<uint16_t>(overflow_policy_len)));
+        // subscription starts between the direct calls
+        auto io_guard = ser->background_access(background_owner::subscribers);
+        auto fan = ser->fanout();
+        uint32_t id = fan->subscribe(policy);
+        wilton_SerialSubscription* sub_ptr = new wilton_SerialSubscription(std::move(fan), id);
+        wilton::support::log_debug(logger, "Subscribed to serial connection, handle: [" + wilton::support::strhandle(ser) + "]," +
+                " subscription: [" + wilton::support::strhandle(sub_ptr) + "]");
+        *sub_out = sub_ptr;
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_SerialSubscription_read(
+        wilton_SerialSubscription* sub,
+        int len,
+        int timeout_millis,
+        char** data_out,
+        int* data_len_out) /* noexcept */ {
+    if (nullptr == sub) return wilton::support::alloc_copy(TRACEMSG("Null 'sub' parameter specified"));
+    if (!sl::support::is_uint32_positive(len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'len' parameter specified: [" + sl::support::to_string(len) + "]"));
+    if (!sl::support::is_uint32(timeout_millis)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'timeout_millis' parameter specified: [" + sl::support::to_string(timeout_millis) + "]"));
+    if (nullptr == data_out) return wilton::support::alloc_copy(TRACEMSG("Null 'data_out' parameter specified"));
+    if (nullptr == data_len_out) return wilton::support::alloc_copy(TRACEMSG("Null 'data_len_out' parameter specified"));
+    try {
+        std::string res;
+        res.resize(static_cast<uint32_t>(len));
+        uint32_t read = sub->impl().read(sub->subscriber_id(), {std::addressof(res.front()), res.length()},
+                static_cast<uint32_t>(timeout_millis));
+        res.resize(read);
+        auto buf = wilton::support::make_string_buffer(res);
+        *data_out = buf.data();
+        *data_len_out = buf.size_int();
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_SerialSubscription_status(
+        wilton_SerialSubscription* sub,
+        char** status_json_out,
+        int* status_json_len_out) /* noexcept */ {
+    if (nullptr == sub) return wilton::support::alloc_copy(TRACEMSG("Null 'sub' parameter specified"));
+    if (nullptr == status_json_out) return wilton::support::alloc_copy(TRACEMSG("Null 'status_json_out' parameter specified"));
+    if (nullptr == status_json_len_out) return wilton::support::alloc_copy(TRACEMSG("Null 'status_json_len_out' parameter specified"));
+    try {
+        auto res = sub->impl().status(sub->subscriber_id()).dumps();
+        auto buf = wilton::support::make_string_buffer(res);
+        *status_json_out = buf.data();
+        *status_json_len_out = buf.size_int();
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_SerialSubscription_close(
+        wilton_SerialSubscription* sub) /* noexcept */ {
+    if (nullptr == sub) return wilton::support::alloc_copy(TRACEMSG("Null 'sub' parameter specified"));
+    try {
+        wilton::support::log_debug(logger, "Closing serial subscription, handle: [" + wilton::support::strhandle(sub) + "] ...");
+        delete sub;
+        wilton::support::log_debug(logger, "Subscription closed");
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
+
+char* wilton_Serial_scan(
+        const char* conf,
+        int conf_len,
+        char** result_out,
+        int* result_len_out) /* noexcept */ {
+    if (nullptr == conf) return wilton::support::alloc_copy(TRACEMSG("Null 'conf' parameter specified"));
+    if (!sl::support::is_uint32_positive(conf_len)) return wilton::support::alloc_copy(TRACEMSG(
+            "Invalid 'conf_len' parameter specified: [" + sl::support::to_string(conf_len) + "]"));
+    if (nullptr == result_out) return wilton::support::alloc_copy(TRACEMSG("Null 'result_out' parameter specified"));
+    if (nullptr == result_len_out) return wilton::support::alloc_copy(TRACEMSG("Null 'result_len_out' parameter specified"));
+    try {
+        auto conf_json = sl::json::load({conf, conf_len});
+        wilton::serial::port_scanner scanner(conf_json);
+        wilton::support::log_debug(logger, "Scanning serial ports ...");
+        auto matched = scanner.scan();
+        wilton::support::log_debug(logger, "Scan complete, configs matched: [" +
+                sl::support::to_string(matched.size()) + "]");
+        auto res = sl::json::value(std::move(matched)).dumps();
+        auto buf = wilton::support::make_string_buffer(res);
+        *result_out = buf.data();
+        *result_len_out = buf.size_int();
+        return nullptr;
+    } catch (const std::exception& e) {
+        return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
+    }
+}
@@ -22,8 +22,11 @@
  */
 
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "staticlib/config.hpp"
 #include "staticlib/io.hpp"
@@ -39,6 +42,9 @@
 #include "wilton/support/registrar.hpp"
 #include "wilton/support/unique_handle_registry.hpp"
 
+#include "buffer_pool.hpp"
+#include "hex_codec.hpp"
+
 namespace wilton {
 namespace serial {
 
@@ -53,6 +59,22 @@ std::shared_ptr<support::unique_handle_registry<wilton_Serial>> serial_registry(
     return registry;
 }
 
+// initialized from wilton_module_init
+std::shared_ptr<support::unique_handle_registry<wilton_SerialSubscription>> subscription_registry() {
+    static auto registry = std::make_shared<support::unique_handle_registry<wilton_SerialSubscription>>(
+            [](wilton_SerialSubscription* sub) STATICLIB_NOEXCEPT {
+                wilton_SerialSubscription_close(sub);
+            });
+    return registry;
+}
+
+// scratch buffers for the reads with hex output, shared between connections
+buffer_pool& hex_read_pool() {
+    // data and hex for the reads up to 64K
+    static buffer_pool pool{16, 3 * 65536};
+    return pool;
+}
+
 } // namespace
 
 support::buffer open(sl::io::span<const char> data) {
@@ -66,6 +88,90 @@ support::buffer open(sl::io::span<const char> data) {
     });
 }
 
+support::buffer open_profile(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    auto rprofile = std::ref(sl::utils::empty_string());
+    auto rport = std::ref(sl::utils::empty_string());
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("profile" == name) {
+            rprofile = fi.as_string_nonempty_or_throw(name);
+        } else if ("port" == name) {
+            rport = fi.as_string_nonempty_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (rprofile.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'profile' not specified"));
+    const std::string& profile = rprofile.get();
+    const std::string& port = rport.get();
+    // call wilton
+    wilton_Serial* ser = nullptr;
+    char* err = wilton_Serial_open_profile(std::addressof(ser), profile.c_str(), static_cast<int>(profile.length()),
+            port.c_str(), static_cast<int>(port.length()));
+    if (nullptr != err) support::throw_wilton_error(err, TRACEMSG(err));
+    auto reg = serial_registry();
+    int64_t handle = reg->put(ser);
+    return support::make_json_buffer({
+        { "serialHandle", handle}
+    });
+}
+
+support::buffer register_profile(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    auto rname = std::ref(sl::utils::empty_string());
+    std::string conf;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("name" == name) {
+            rname = fi.as_string_nonempty_or_throw(name);
+        } else if ("config" == name) {
+            // validated on registration
+            conf = fi.val().dumps();
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (rname.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'name' not specified"));
+    if (conf.empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'config' not specified"));
+    const std::string& name = rname.get();
+    // call wilton
+    char* err = wilton_Serial_register_profile(name.c_str(), static_cast<int>(name.length()),
+            conf.c_str(), static_cast<int>(conf.length()));
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    return support::make_null_buffer();
+}
+
+support::buffer unregister_profile(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    auto rname = std::ref(sl::utils::empty_string());
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("name" == name) {
+            rname = fi.as_string_nonempty_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (rname.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'name' not specified"));
+    const std::string& name = rname.get();
+    // call wilton
+    char* err = wilton_Serial_unregister_profile(name.c_str(), static_cast<int>(name.length()));
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    return support::make_null_buffer();
+}
+
 support::buffer close(sl::io::span<const char> data) {
     // json parse
     auto json = sl::json::load(data);
@@ -116,12 +222,69 @@ support::buffer read(sl::io::span<const char> data) {
     // get handle
     auto reg = serial_registry();
     wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    if (len <= 0 || len > std::numeric_limits<int>::max() / 3) {
+        reg->put(ser);
+        throw support::exception(TRACEMSG(
+                "Invalid 'length' parameter specified: [" + sl::support::to_string(len) + "]"));
+    }
+    // data is read into the first third of the buffer, hex goes after it
+    auto pooled = hex_read_pool().acquire(static_cast<size_t>(len) * 3);
+    auto span = pooled.span();
+    // call wilton
+    int out_len = 0;
+    char* err = wilton_Serial_read_into(ser, span.data(), static_cast<int>(len),
+            std::addressof(out_len));
+    reg->put(ser);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    // return hex
+    auto data_len = static_cast<size_t>(out_len);
+    auto hex_len = hex_encode_into({span.data(), data_len},
+            {span.data() + len, data_len * 2});
+    return support::make_array_buffer(span.data() + len, static_cast<int>(hex_len));
+}
+
+support::buffer read_timestamped(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    int64_t len = -1;
+    uint32_t timeout_millis = 0;
+    bool strip_nul = false;
+    bool mask_parity = false;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("length" == name) {
+            len = fi.as_int64_or_throw(name);
+        } else if ("timeoutMillis" == name) {
+            timeout_millis = fi.as_uint32_positive_or_throw(name);
+        } else if ("stripNul" == name) {
+            strip_nul = fi.as_bool_or_throw(name);
+        } else if ("maskParity" == name) {
+            mask_parity = fi.as_bool_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    if (-1 == len) throw support::exception(TRACEMSG(
+            "Required parameter 'length' not specified"));
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
     if (nullptr == ser) throw support::exception(TRACEMSG(
             "Invalid 'serialHandle' parameter specified"));
     // call wilton
     char* out = nullptr;
     int out_len = 0;
-    char* err = wilton_Serial_read(ser, static_cast<int>(len),
+    char* err = wilton_Serial_read_timestamped(ser, static_cast<int>(len),
+            static_cast<int>(timeout_millis), strip_nul ? 1 : 0, mask_parity ? 1 : 0,
             std::addressof(out), std::addressof(out_len));
     reg->put(ser);
     if (nullptr != err) {
@@ -134,8 +297,8 @@ support::buffer read(sl::io::span<const char> data) {
         wilton_free(out);
     });
     // return hex
-    auto src = sl::io::array_source(out, out_len);
-    return support::make_hex_buffer(src);
+    auto hex = hex_encode({out, out_len});
+    return support::make_string_buffer(hex);
 }
 
 support::buffer readline(sl::io::span<const char> data) {
@@ -172,8 +335,196 @@ support::buffer readline(sl::io::span<const char> data) {
         wilton_free(out);
     });
     // return hex
-    auto src = sl::io::array_source(out, out_len);
-    return support::make_hex_buffer(src);
+    auto hex = hex_encode({out, out_len});
+    return support::make_string_buffer(hex);
+}
+
+support::buffer readlines(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    uint32_t max_lines = 64;
+    uint32_t timeout_millis = 0;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("maxLines" == name) {
+            max_lines = fi.as_uint32_positive_or_throw(name);
+        } else if ("timeoutMillis" == name) {
+            timeout_millis = fi.as_uint32_positive_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    char* out = nullptr;
+    int out_len = 0;
+    char* err = wilton_Serial_readlines(ser, static_cast<int>(max_lines),
+            static_cast<int>(timeout_millis), std::addressof(out), std::addressof(out_len));
+    reg->put(ser);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    auto deferred = sl::support::defer([out]() STATICLIB_NOEXCEPT {
+        wilton_free(out);
+    });
+    return support::make_array_buffer(out, out_len);
+}
+
+support::buffer read_nmea(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    uint32_t max_sentences = 64;
+    uint32_t timeout_millis = 0;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("maxSentences" == name) {
+            max_sentences = fi.as_uint32_positive_or_throw(name);
+        } else if ("timeoutMillis" == name) {
+            timeout_millis = fi.as_uint32_positive_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    char* out = nullptr;
+    int out_len = 0;
+    char* err = wilton_Serial_read_nmea(ser, static_cast<int>(max_sentences),
+            static_cast<int>(timeout_millis), std::addressof(out), std::addressof(out_len));
+    reg->put(ser);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    auto deferred = sl::support::defer([out]() STATICLIB_NOEXCEPT {
+        wilton_free(out);
+    });
+    return support::make_array_buffer(out, out_len);
+}
+
+support::buffer read_frames(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    auto rframing = std::ref(sl::utils::empty_string());
+    uint32_t max_frames = 64;
+    uint32_t timeout_millis = 0;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("framing" == name) {
+            rframing = fi.as_string_nonempty_or_throw(name);
+        } else if ("maxFrames" == name) {
+            max_frames = fi.as_uint32_positive_or_throw(name);
+        } else if ("timeoutMillis" == name) {
+            timeout_millis = fi.as_uint32_positive_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    if (rframing.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'framing' not specified"));
+    const std::string& framing = rframing.get();
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    char* out = nullptr;
+    int out_len = 0;
+    char* err = wilton_Serial_read_frames(ser, framing.c_str(), static_cast<int>(framing.length()),
+            static_cast<int>(max_frames), static_cast<int>(timeout_millis),
+            std::addressof(out), std::addressof(out_len));
+    reg->put(ser);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    auto deferred = sl::support::defer([out]() STATICLIB_NOEXCEPT {
+        wilton_free(out);
+    });
+    return support::make_array_buffer(out, out_len);
+}
+
+support::buffer read_many(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    auto handles = std::vector<int64_t>();
+    int64_t len = -1;
+    int64_t timeout = 0;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandles" == name) {
+            for (const sl::json::value& va : fi.as_array_or_throw(name)) {
+                handles.push_back(va.as_int64_or_throw(name));
+            }
+        } else if ("length" == name) {
+            len = fi.as_int64_or_throw(name);
+        } else if ("timeoutMillis" == name) {
+            timeout = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (handles.empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandles' not specified"));
+    if (-1 == len) throw support::exception(TRACEMSG(
+            "Required parameter 'length' not specified"));
+    // handle can be taken from the registry only once, results are keyed by handle
+    auto sorted = handles;
+    std::sort(sorted.begin(), sorted.end());
+    auto dup = std::adjacent_find(sorted.begin(), sorted.end());
+    if (sorted.end() != dup) throw support::exception(TRACEMSG(
+            "Duplicate 'serialHandles' element specified: [" + sl::support::to_string(*dup) + "]"));
+    // get handles
+    auto reg = serial_registry();
+    auto sers = std::vector<wilton_Serial*>();
+    auto deferred_put = sl::support::defer([&reg, &sers]() STATICLIB_NOEXCEPT {
+        for (wilton_Serial* ser : sers) {
+            reg->put(ser);
+        }
+    });
+    for (int64_t ha : handles) {
+        wilton_Serial* ser = reg->remove(ha);
+        if (nullptr == ser) throw support::exception(TRACEMSG(
+                "Invalid 'serialHandles' element specified: [" + sl::support::to_string(ha) + "]"));
+        sers.push_back(ser);
+    }
+    // call wilton
+    auto keys = std::vector<long long>(handles.begin(), handles.end());
+    char* out = nullptr;
+    int out_len = 0;
+    char* err = wilton_Serial_read_many(sers.data(), static_cast<int>(sers.size()),
+            keys.data(), static_cast<int>(len), static_cast<int>(timeout),
+            std::addressof(out), std::addressof(out_len));
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    auto deferred = sl::support::defer([out]() STATICLIB_NOEXCEPT {
+        wilton_free(out);
+    });
+    // ports with data or errors, keyed by handle
+    return support::make_array_buffer(out, out_len);
 }
 
 support::buffer write(sl::io::span<const char> data) {
@@ -196,7 +547,7 @@ support::buffer write(sl::io::span<const char> data) {
     if (rdatahex.get().empty()) throw support::exception(TRACEMSG(
             "Required parameter 'dataHex' not specified"));
     // decode hex
-    auto sdata = sl::io::string_from_hex(rdatahex.get());
+    auto sdata = hex_decode({rdatahex.get().data(), rdatahex.get().length()});
     // get handle
     auto reg = serial_registry();
     wilton_Serial* ser = reg->remove(handle);
@@ -213,17 +564,982 @@ support::buffer write(sl::io::span<const char> data) {
     });
 }
 
+support::buffer write_drain(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    auto rdatahex = std::ref(sl::utils::empty_string());
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("dataHex" == name) {
+            rdatahex = fi.as_string_nonempty_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    if (rdatahex.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'dataHex' not specified"));
+    // decode hex
+    auto sdata = hex_decode({rdatahex.get().data(), rdatahex.get().length()});
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    int written_out = 0;
+    char* err = wilton_Serial_write_drain(ser, sdata.c_str(), 
+            static_cast<int> (sdata.length()), std::addressof(written_out));
+    reg->put(ser);
+    if (nullptr != err) support::throw_wilton_error(err, TRACEMSG(err));
+    return support::make_json_buffer({
+        { "bytesWritten", written_out }
+    });
+}
+
+support::buffer flush(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    char* err = wilton_Serial_flush(ser);
+    reg->put(ser);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    return support::make_null_buffer();
+}
+
+support::buffer drain(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    char* err = wilton_Serial_drain(ser);
+    reg->put(ser);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    return support::make_null_buffer();
+}
+
+support::buffer send_file(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    auto rpath = std::ref(sl::utils::empty_string());
+    uint32_t chunk_size = 4096;
+    uint32_t chunk_delay_millis = 0;
+    uint32_t max_bytes = 0;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("path" == name) {
+            rpath = fi.as_string_nonempty_or_throw(name);
+        } else if ("chunkSize" == name) {
+            chunk_size = fi.as_uint32_positive_or_throw(name);
+        } else if ("chunkDelayMillis" == name) {
+            chunk_delay_millis = fi.as_uint32_or_throw(name);
+        } else if ("maxBytes" == name) {
+            max_bytes = fi.as_uint32_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    if (rpath.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'path' not specified"));
+    const std::string& path = rpath.get();
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    int written_out = 0;
+    char* err = wilton_Serial_send_file(ser, path.c_str(), static_cast<int>(path.length()),
+            static_cast<int>(chunk_size), static_cast<int>(chunk_delay_millis),
+            static_cast<int>(max_bytes), std::addressof(written_out));
+    reg->put(ser);
+    if (nullptr != err) support::throw_wilton_error(err, TRACEMSG(err));
+    return support::make_json_buffer({
+        { "bytesWritten", written_out }
+    });
+}
+
+support::buffer receive_to_file(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    auto rpath = std::ref(sl::utils::empty_string());
+    uint32_t chunk_size = 4096;
+    uint32_t max_bytes = 0;
+    auto rterminatorhex = std::ref(sl::utils::empty_string());
+    uint32_t idle_timeout_millis = 0;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("path" == name) {
+            rpath = fi.as_string_nonempty_or_throw(name);
+        } else if ("chunkSize" == name) {
+            chunk_size = fi.as_uint32_positive_or_throw(name);
+        } else if ("maxBytes" == name) {
+            max_bytes = fi.as_uint32_or_throw(name);
+        } else if ("terminatorHex" == name) {
+            rterminatorhex = fi.as_string_nonempty_or_throw(name);
+        } else if ("idleTimeoutMillis" == name) {
+            idle_timeout_millis = fi.as_uint32_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    if (rpath.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'path' not specified"));
+    const std::string& path = rpath.get();
+    // decode hex
+    auto terminator = hex_decode({rterminatorhex.get().data(), rterminatorhex.get().length()});
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    int read_out = 0;
+    char* err = wilton_Serial_receive_to_file(ser, path.c_str(), static_cast<int>(path.length()),
+            static_cast<int>(chunk_size), static_cast<int>(max_bytes),
+            terminator.c_str(), static_cast<int>(terminator.length()),
+            static_cast<int>(idle_timeout_millis), std::addressof(read_out));
+    reg->put(ser);
+    if (nullptr != err) support::throw_wilton_error(err, TRACEMSG(err));
+    return support::make_json_buffer({
+        { "bytesRead", read_out }
+    });
+}
+
+support::buffer xmodem_send(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    auto rpath = std::ref(sl::utils::empty_string());
+    std::string protocol = "XMODEM_1K";
+    uint32_t retries = 10;
+    uint32_t timeout_millis = 10000;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("path" == name) {
+            rpath = fi.as_string_nonempty_or_throw(name);
+        } else if ("protocol" == name) {
+            protocol = fi.as_string_nonempty_or_throw(name);
+        } else if ("retries" == name) {
+            retries = fi.as_uint32_positive_or_throw(name);
+        } else if ("timeoutMillis" == name) {
+            timeout_millis = fi.as_uint32_positive_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    if (rpath.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'path' not specified"));
+    const std::string& path = rpath.get();
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    int written_out = 0;
+    char* err = wilton_Serial_xmodem_send(ser, path.c_str(), static_cast<int>(path.length()),
+            protocol.c_str(), static_cast<int>(protocol.length()),
+            static_cast<int>(retries), static_cast<int>(timeout_millis),
+            nullptr, nullptr, std::addressof(written_out));
+    reg->put(ser);
+    if (nullptr != err) support::throw_wilton_error(err, TRACEMSG(err));
+    return support::make_json_buffer({
+        { "bytesWritten", written_out }
+    });
+}
+
+support::buffer xmodem_receive(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    auto rpath = std::ref(sl::utils::empty_string());
+    std::string protocol = "XMODEM_1K";
+    uint32_t retries = 10;
+    uint32_t timeout_millis = 10000;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("path" == name) {
+            rpath = fi.as_string_nonempty_or_throw(name);
+        } else if ("protocol" == name) {
+            protocol = fi.as_string_nonempty_or_throw(name);
+        } else if ("retries" == name) {
+            retries = fi.as_uint32_positive_or_throw(name);
+        } else if ("timeoutMillis" == name) {
+            timeout_millis = fi.as_uint32_positive_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    if (rpath.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'path' not specified"));
+    const std::string& path = rpath.get();
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    char* name_out = nullptr;
+    int name_len_out = 0;
+    int read_out = 0;
+    char* err = wilton_Serial_xmodem_receive(ser, path.c_str(), static_cast<int>(path.length()),
+            protocol.c_str(), static_cast<int>(protocol.length()),
+            static_cast<int>(retries), static_cast<int>(timeout_millis),
+            nullptr, nullptr, std::addressof(name_out), std::addressof(name_len_out),
+            std::addressof(read_out));
+    reg->put(ser);
+    if (nullptr != err) support::throw_wilton_error(err, TRACEMSG(err));
+    auto deferred = sl::support::defer([name_out]() STATICLIB_NOEXCEPT {
+        wilton_free(name_out);
+    });
+    return support::make_json_buffer({
+        { "bytesRead", read_out },
+        { "fileName", std::string(name_out, static_cast<size_t>(name_len_out)) }
+    });
+}
+
+support::buffer get_modem_lines(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    char* out = nullptr;
+    int out_len = 0;
+    char* err = wilton_Serial_get_modem_lines(ser, std::addressof(out), std::addressof(out_len));
+    reg->put(ser);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    auto deferred = sl::support::defer([out]() STATICLIB_NOEXCEPT {
+        wilton_free(out);
+    });
+    return support::make_array_buffer(out, out_len);
+}
+
+support::buffer set_modem_line(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    auto rline = std::ref(sl::utils::empty_string());
+    int value = -1;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("line" == name) {
+            rline = fi.as_string_nonempty_or_throw(name);
+        } else if ("value" == name) {
+            value = fi.as_bool_or_throw(name) ? 1 : 0;
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    if (rline.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'line' not specified"));
+    if (-1 == value) throw support::exception(TRACEMSG(
+            "Required parameter 'value' not specified"));
+    const std::string& line = rline.get();
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    char* err = wilton_Serial_set_modem_line(ser, line.c_str(), static_cast<int>(line.length()), value);
+    reg->put(ser);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    return support::make_null_buffer();
+}
+
+support::buffer send_break(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    int64_t duration = 0;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("durationMillis" == name) {
+            duration = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    char* err = wilton_Serial_send_break(ser, static_cast<int>(duration));
+    reg->put(ser);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    return support::make_null_buffer();
+}
+
+support::buffer wait_modem_change(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    std::string lines;
+    int64_t timeout = 0;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("lines" == name) {
+            for (const sl::json::value& va : fi.as_array_or_throw(name)) {
+                if (!lines.empty()) {
+                    lines.push_back(',');
+                }
+                lines.append(va.as_string_nonempty_or_throw(name));
+            }
+        } else if ("timeoutMillis" == name) {
+            timeout = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    if (lines.empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'lines' not specified"));
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    int changed = 0;
+    char* err = wilton_Serial_wait_modem_change(ser, lines.c_str(), static_cast<int>(lines.length()),
+            static_cast<int>(timeout), std::addressof(changed));
+    reg->put(ser);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    return support::make_json_buffer({
+        { "changed", 0 != changed }
+    });
+}
+
+support::buffer status(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    char* out = nullptr;
+    int out_len = 0;
+    char* err = wilton_Serial_status(ser, std::addressof(out), std::addressof(out_len));
+    reg->put(ser);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    auto deferred = sl::support::defer([out]() STATICLIB_NOEXCEPT {
+        wilton_free(out);
+    });
+    return support::make_array_buffer(out, out_len);
+}
+
+support::buffer poll_start(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    auto conf_fields = std::vector<sl::json::field>();
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else {
+            // validated by the scheduler
+            conf_fields.emplace_back(name, fi.val().clone());
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    auto conf = sl::json::value(std::move(conf_fields)).dumps();
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    char* err = wilton_Serial_poll_start(ser, conf.c_str(), static_cast<int>(conf.length()));
+    reg->put(ser);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    return support::make_null_buffer();
+}
+
+support::buffer poll_results(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    char* out = nullptr;
+    int out_len = 0;
+    char* err = wilton_Serial_poll_results(ser, std::addressof(out), std::addressof(out_len));
+    reg->put(ser);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    auto deferred = sl::support::defer([out]() STATICLIB_NOEXCEPT {
+        wilton_free(out);
+    });
+    return support::make_array_buffer(out, out_len);
+}
+
+support::buffer poll_stop(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    char* err = wilton_Serial_poll_stop(ser);
+    reg->put(ser);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    return support::make_null_buffer();
+}
+
+support::buffer watch_start(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    auto conf_fields = std::vector<sl::json::field>();
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else {
+            // validated by the watcher
+            conf_fields.emplace_back(name, fi.val().clone());
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    auto conf = sl::json::value(std::move(conf_fields)).dumps();
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    char* err = wilton_Serial_watch_start(ser, conf.c_str(), static_cast<int>(conf.length()));
+    reg->put(ser);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    return support::make_null_buffer();
+}
+
+support::buffer watch_wait(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    int64_t max_matches = 16;
+    int64_t timeout = 0;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("maxMatches" == name) {
+            max_matches = fi.as_int64_or_throw(name);
+        } else if ("timeoutMillis" == name) {
+            timeout = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    char* out = nullptr;
+    int out_len = 0;
+    char* err = wilton_Serial_watch_wait(ser, static_cast<int>(max_matches), static_cast<int>(timeout),
+            std::addressof(out), std::addressof(out_len));
+    reg->put(ser);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    auto deferred = sl::support::defer([out]() STATICLIB_NOEXCEPT {
+        wilton_free(out);
+    });
+    return support::make_array_buffer(out, out_len);
+}
+
+support::buffer watch_stop(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    char* err = wilton_Serial_watch_stop(ser);
+    reg->put(ser);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    return support::make_null_buffer();
+}
+
+support::buffer shm_start(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    auto conf_fields = std::vector<sl::json::field>();
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else {
+            // validated by the ring
+            conf_fields.emplace_back(name, fi.val().clone());
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    auto conf = sl::json::value(std::move(conf_fields)).dumps();
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    char* out = nullptr;
+    int out_len = 0;
+    char* err = wilton_Serial_shm_start(ser, conf.c_str(), static_cast<int>(conf.length()),
+            std::addressof(out), std::addressof(out_len));
+    reg->put(ser);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    auto deferred = sl::support::defer([out]() STATICLIB_NOEXCEPT {
+        wilton_free(out);
+    });
+    return support::make_array_buffer(out, out_len);
+}
+
+support::buffer shm_advance(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    int64_t len = 0;
+    int64_t timeout = 0;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("length" == name) {
+            len = fi.as_int64_or_throw(name);
+        } else if ("timeoutMillis" == name) {
+            timeout = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    long long read_pos = 0;
+    long long write_pos = 0;
+    char* err = wilton_Serial_shm_advance(ser, static_cast<int>(len), static_cast<int>(timeout),
+            std::addressof(read_pos), std::addressof(write_pos));
+    reg->put(ser);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    return support::make_json_buffer({
+        { "readPosition", static_cast<int64_t>(read_pos) },
+        { "writePosition", static_cast<int64_t>(write_pos) }
+    });
+}
+
+support::buffer shm_stop(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    char* err = wilton_Serial_shm_stop(ser);
+    reg->put(ser);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    return support::make_null_buffer();
+}
+
+support::buffer subscribe(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    auto rpolicy = std::ref(sl::utils::empty_string());
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("serialHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("overflowPolicy" == name) {
+            rpolicy = fi.as_string_nonempty_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'serialHandle' not specified"));
+    std::string policy = rpolicy.get().empty() ? std::string("DROP_OLDEST") : rpolicy.get();
+    // get handle
+    auto reg = serial_registry();
+    wilton_Serial* ser = reg->remove(handle);
+    if (nullptr == ser) throw support::exception(TRACEMSG(
+            "Invalid 'serialHandle' parameter specified"));
+    // call wilton
+    wilton_SerialSubscription* sub = nullptr;
+    char* err = wilton_Serial_subscribe(ser, policy.c_str(), static_cast<int>(policy.length()),
+            std::addressof(sub));
+    reg->put(ser);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    auto sreg = subscription_registry();
+    int64_t sub_handle = sreg->put(sub);
+    return support::make_json_buffer({
+        { "subscriptionHandle", sub_handle}
+    });
+}
+
+support::buffer subscription_read(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    int64_t len = -1;
+    int64_t timeout = 0;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("subscriptionHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("length" == name) {
+            len = fi.as_int64_or_throw(name);
+        } else if ("timeoutMillis" == name) {
+            timeout = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'subscriptionHandle' not specified"));
+    if (-1 == len) throw support::exception(TRACEMSG(
+            "Required parameter 'length' not specified"));
+    // get handle
+    auto reg = subscription_registry();
+    wilton_SerialSubscription* sub = reg->remove(handle);
+    if (nullptr == sub) throw support::exception(TRACEMSG(
+            "Invalid 'subscriptionHandle' parameter specified"));
+    // call wilton
+    char* out = nullptr;
+    int out_len = 0;
+    char* err = wilton_SerialSubscription_read(sub, static_cast<int>(len), static_cast<int>(timeout),
+            std::addressof(out), std::addressof(out_len));
+    reg->put(sub);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    if (nullptr == out) { // cannot happen
+        return support::make_null_buffer();
+    }
+    auto deferred = sl::support::defer([out]() STATICLIB_NOEXCEPT {
+        wilton_free(out);
+    });
+    // return hex
+    auto hex = hex_encode({out, out_len});
+    return support::make_string_buffer(hex);
+}
+
+support::buffer subscription_status(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("subscriptionHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'subscriptionHandle' not specified"));
+    // get handle
+    auto reg = subscription_registry();
+    wilton_SerialSubscription* sub = reg->remove(handle);
+    if (nullptr == sub) throw support::exception(TRACEMSG(
+            "Invalid 'subscriptionHandle' parameter specified"));
+    // call wilton
+    char* out = nullptr;
+    int out_len = 0;
+    char* err = wilton_SerialSubscription_status(sub, std::addressof(out), std::addressof(out_len));
+    reg->put(sub);
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    auto deferred = sl::support::defer([out]() STATICLIB_NOEXCEPT {
+        wilton_free(out);
+    });
+    return support::make_array_buffer(out, out_len);
+}
+
+support::buffer subscription_close(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("subscriptionHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'subscriptionHandle' not specified"));
+    // get handle
+    auto reg = subscription_registry();
+    wilton_SerialSubscription* sub = reg->remove(handle);
+    if (nullptr == sub) throw support::exception(TRACEMSG(
+            "Invalid 'subscriptionHandle' parameter specified"));
+    // call wilton
+    char* err = wilton_SerialSubscription_close(sub);
+    if (nullptr != err) {
+        reg->put(sub);
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    return support::make_null_buffer();
+}
+
+support::buffer scan(sl::io::span<const char> data) {
+    // call wilton
+    char* out = nullptr;
+    int out_len = 0;
+    char* err = wilton_Serial_scan(data.data(), data.size_int(),
+            std::addressof(out), std::addressof(out_len));
+    if (nullptr != err) {
+        support::throw_wilton_error(err, TRACEMSG(err));
+    }
+    auto deferred = sl::support::defer([out]() STATICLIB_NOEXCEPT {
+        wilton_free(out);
+    });
+    return support::make_array_buffer(out, out_len);
+}
+
 } // namespace
 }
 
 extern "C" char* wilton_module_init() {
     try {
         wilton::serial::serial_registry();
+        wilton::serial::subscription_registry();
         wilton::support::register_wiltoncall("serial_open", wilton::serial::open);
+        wilton::support::register_wiltoncall("serial_open_profile", wilton::serial::open_profile);
+        wilton::support::register_wiltoncall("serial_register_profile", wilton::serial::register_profile);
+        wilton::support::register_wiltoncall("serial_unregister_profile", wilton::serial::unregister_profile);
         wilton::support::register_wiltoncall("serial_close", wilton::serial::close);
         wilton::support::register_wiltoncall("serial_read", wilton::serial::read);
+        wilton::support::register_wiltoncall("serial_read_timestamped", wilton::serial::read_timestamped);
         wilton::support::register_wiltoncall("serial_readline", wilton::serial::readline);
+        wilton::support::register_wiltoncall("serial_readlines", wilton::serial::readlines);
+        wilton::support::register_wiltoncall("serial_read_nmea", wilton::serial::read_nmea);
+        wilton::support::register_wiltoncall("serial_read_frames", wilton::serial::read_frames);
+        wilton::support::register_wiltoncall("serial_read_many", wilton::serial::read_many);
         wilton::support::register_wiltoncall("serial_write", wilton::serial::write);
+        wilton::support::register_wiltoncall("serial_write_drain", wilton::serial::write_drain);
+        wilton::support::register_wiltoncall("serial_flush", wilton::serial::flush);
+        wilton::support::register_wiltoncall("serial_drain", wilton::serial::drain);
+        wilton::support::register_wiltoncall("serial_send_file", wilton::serial::send_file);
+        wilton::support::register_wiltoncall("serial_receive_to_file", wilton::serial::receive_to_file);
+        wilton::support::register_wiltoncall("serial_xmodem_send", wilton::serial::xmodem_send);
+        wilton::support::register_wiltoncall("serial_xmodem_receive", wilton::serial::xmodem_receive);
+        wilton::support::register_wiltoncall("serial_get_modem_lines", wilton::serial::get_modem_lines);
+        wilton::support::register_wiltoncall("serial_set_modem_line", wilton::serial::set_modem_line);
+        wilton::support::register_wiltoncall("serial_send_break", wilton::serial::send_break);
+        wilton::support::register_wiltoncall("serial_wait_modem_change", wilton::serial::wait_modem_change);
+        wilton::support::register_wiltoncall("serial_status", wilton::serial::status);
+        wilton::support::register_wiltoncall("serial_poll_start", wilton::serial::poll_start);
+        wilton::support::register_wiltoncall("serial_poll_results", wilton::serial::poll_results);
+        wilton::support::register_wiltoncall("serial_poll_stop", wilton::serial::poll_stop);
+        wilton::support::register_wiltoncall("serial_watch_start", wilton::serial::watch_start);
+        wilton::support::register_wiltoncall("serial_watch_wait", wilton::serial::watch_wait);
+        wilton::support::register_wiltoncall("serial_watch_stop", wilton::serial::watch_stop);
+        wilton::support::register_wiltoncall("serial_shm_start", wilton::serial::shm_start);
+        wilton::support::register_wiltoncall("serial_shm_advance", wilton::serial::shm_advance);
+        wilton::support::register_wiltoncall("serial_shm_stop", wilton::serial::shm_stop);
+        wilton::support::register_wiltoncall("serial_subscribe", wilton::serial::subscribe);
+        wilton::support::register_wiltoncall("serial_subscription_read", wilton::serial::subscription_read);
+        wilton::support::register_wiltoncall("serial_subscription_status", wilton::serial::subscription_status);
+        wilton::support::register_wiltoncall("serial_subscription_close", wilton::serial::subscription_close);
+        wilton::support::register_wiltoncall("serial_scan", wilton::serial::scan);
         return nullptr;
     } catch (const std::exception& e) {
         return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
@@ -0,0 +1,456 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   xmodem.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 12:30 PM
+ */
+
+#include "xmodem.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+#include "staticlib/tinydir.hpp"
+#include "staticlib/utils.hpp"
+
+#include "wilton/support/exception.hpp"
+
+namespace wilton {
+namespace serial {
+
+namespace { // anonymous
+
+const char SOH = 0x01;
+const char STX = 0x02;
+const char EOT = 0x04;
+const char ACK = 0x06;
+const char NAK = 0x15;
+const char CAN = 0x18;
+const char CRC_START = 'C';
+const char CPMEOF = 0x1a;
+
+const size_t block_size_short = 128;
+const size_t block_size_long = 1024;
+// number of 'C' start requests before falling back to checksum mode
+const uint32_t crc_start_attempts = 3;
+
+enum class block_status {
+    ok,
+    eot,
+    cancel,
+    timeout,
+    bad
+};
+
+const std::array<uint16_t, 256>& crc16_table() {
+    static std::array<uint16_t, 256> table = [] {
+        std::array<uint16_t, 256> res;
+        for (uint16_t i = 0; i < 256; i++) {
+            uint16_t crc = static_cast<uint16_t>(i << 8);
+            for (int j = 0; j < 8; j++) {
+                crc = static_cast<uint16_t>((crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1);
+            }
+            res[i] = crc;
+        }
+        return res;
+    }();
+    return table;
+}
+
+uint16_t crc16(const char* data, size_t len) {
+    auto& table = crc16_table();
+    uint16_t crc = 0;
+    for (size_t i = 0; i < len; i++) {
+        uint8_t idx = static_cast<uint8_t>((crc >> 8) ^ static_cast<uint8_t>(data[i]));
+        crc = static_cast<uint16_t>((crc << 8) ^ table[idx]);
+    }
+    return crc;
+}
+
+uint8_t checksum(const char* data, size_t len) {
+    uint8_t sum = 0;
+    for (size_t i = 0; i < len; i++) {
+        sum = static_cast<uint8_t>(sum + static_cast<uint8_t>(data[i]));
+    }
+    return sum;
+}
+
+// returns -1 on timeout
+int read_byte(connection& conn, uint32_t timeout_millis) {
+    char ch = '\0';
+    uint32_t read = conn.read_available({std::addressof(ch), 1}, timeout_millis);
+    if (0 == read) {
+        return -1;
+    }
+    return static_cast<int>(static_cast<unsigned char>(ch));
+}
+
+bool read_exact(connection& conn, char* buf, size_t len, uint32_t timeout_millis) {
+    uint64_t start = sl::utils::current_time_millis_steady();
+    size_t filled = 0;
+    while (filled < len) {
+        uint64_t passed = sl::utils::current_time_millis_steady() - start;
+        if (passed >= timeout_millis) {
+            return false;
+        }
+        filled += conn.read_available({buf + filled, len - filled},
+                static_cast<uint32_t>(timeout_millis - passed));
+    }
+    return true;
+}
+
+void write_exact(connection& conn, sl::io::span<const char> data) {
+    uint32_t written = conn.write(data);
+    if (written != data.size()) throw support::exception(TRACEMSG(
+            "XMODEM write timeout, bytes to write: [" + sl::support::to_string(data.size()) + "]," +
+            " bytes written: [" + sl::support::to_string(written) + "]"));
+}
+
+void write_byte(connection& conn, char ch) {
+    write_exact(conn, {std::addressof(ch), 1});
+}
+
+// drains the line noise after a broken block
+void purge_input(connection& conn) {
+    std::array<char, 256> buf;
+    while (conn.read_available({buf.data(), buf.size()}, 100) > 0) { }
+}
+
+void cancel_transfer(connection& conn) {
+    const char cancel[] = { CAN, CAN, CAN };
+    conn.write({cancel, sizeof(cancel)});
+}
+
+void throw_canceled() {
+    throw support::exception(TRACEMSG("XMODEM transfer canceled by the remote side"));
+}
+
+size_t block_size(xmodem_protocol protocol) {
+    return xmodem_protocol::xmodem == protocol ? block_size_short : block_size_long;
+}
+
+void make_frame(std::string& frame, uint8_t blk, const char* data, size_t len, size_t size, bool crc, char pad) {
+    frame.clear();
+    frame.push_back(block_size_short == size ? SOH : STX);
+    frame.push_back(static_cast<char>(blk));
+    frame.push_back(static_cast<char>(~blk));
+    frame.append(data, len);
+    frame.append(size - len, pad);
+    const char* payload = frame.data() + 3;
+    if (crc) {
+        uint16_t sum = crc16(payload, size);
+        frame.push_back(static_cast<char>(sum >> 8));
+        frame.push_back(static_cast<char>(sum & 0xff));
+    } else {
+        frame.push_back(static_cast<char>(checksum(payload, size)));
+    }
+}
+
+// returns true for CRC mode, false for checksum mode
+bool wait_for_receiver(connection& conn, const xmodem_options& opts) {
+    for (uint32_t i = 0; i < opts.retries; i++) {
+        int ch = read_byte(conn, opts.timeout_millis);
+        if (CRC_START == ch) {
+            return true;
+        } else if (NAK == ch) {
+            return false;
+        } else if (CAN == ch) {
+            if (CAN == read_byte(conn, opts.timeout_millis)) {
+                throw_canceled();
+            }
+        }
+    }
+    throw support::exception(TRACEMSG("XMODEM receiver start timeout," +
+            " attempts: [" + sl::support::to_string(opts.retries) + "]"));
+}
+
+void send_frame(connection& conn, const std::string& frame, uint8_t blk, const xmodem_options& opts) {
+    for (uint32_t i = 0; i < opts.retries; i++) {
+        write_exact(conn, {frame.data(), frame.length()});
+        int ch = read_byte(conn, opts.timeout_millis);
+        if (ACK == ch) {
+            return;
+        } else if (CAN == ch) {
+            if (CAN == read_byte(conn, opts.timeout_millis)) {
+                throw_canceled();
+            }
+        }
+        // NAK, timeout or noise - resend
+    }
+    cancel_transfer(conn);
+    throw support::exception(TRACEMSG("XMODEM block send error," +
+            " block: [" + sl::support::to_string(static_cast<int>(blk)) + "]," +
+            " attempts: [" + sl::support::to_string(opts.retries) + "]"));
+}
+
+void send_eot(connection& conn, const xmodem_options& opts) {
+    for (uint32_t i = 0; i < opts.retries; i++) {
+        write_byte(conn, EOT);
+        int ch = read_byte(conn, opts.timeout_millis);
+        if (ACK == ch) {
+            return;
+        }
+        // YMODEM receivers NAK the first EOT
+    }
+    throw support::exception(TRACEMSG("XMODEM EOT not acknowledged," +
+            " attempts: [" + sl::support::to_string(opts.retries) + "]"));
+}
+
+block_status read_block(connection& conn, bool crc, const xmodem_options& opts,
+        std::string& buf, uint8_t& blk_out) {
+    int header = read_byte(conn, opts.timeout_millis);
+    if (-1 == header) {
+        return block_status::timeout;
+    } else if (EOT == header) {
+        return block_status::eot;
+    } else if (CAN == header) {
+        if (CAN == read_byte(conn, opts.timeout_millis)) {
+            return block_status::cancel;
+        }
+        return block_status::bad;
+    } else if (SOH != header && STX != header) {
+        purge_input(conn);
+        return block_status::bad;
+    }
+    size_t size = SOH == header ? block_size_short : block_size_long;
+    size_t tail = crc ? 2 : 1;
+    buf.resize(2 + size + tail);
+    if (!read_exact(conn, std::addressof(buf.front()), buf.length(), opts.timeout_millis)) {
+        return block_status::bad;
+    }
+    uint8_t blk = static_cast<uint8_t>(buf[0]);
+    uint8_t blk_inv = static_cast<uint8_t>(buf[1]);
+    if (static_cast<uint8_t>(~blk) != blk_inv) {
+        purge_input(conn);
+        return block_status::bad;
+    }
+    const char* payload = buf.data() + 2;
+    if (crc) {
+        uint16_t expected = static_cast<uint16_t>(
+                (static_cast<uint8_t>(buf[2 + size]) << 8) | static_cast<uint8_t>(buf[3 + size]));
+        if (crc16(payload, size) != expected) {
+            return block_status::bad;
+        }
+    } else if (checksum(payload, size) != static_cast<uint8_t>(buf[2 + size])) {
+        return block_status::bad;
+    }
+    // leave payload only
+    buf.erase(0, 2);
+    buf.resize(size);
+    blk_out = blk;
+    return block_status::ok;
+}
+
+// YMODEM block 0: "name\0size [mtime mode ...]\0"
+void parse_ymodem_header(const std::string& payload, xmodem_result& res, uint64_t& total) {
+    auto name_end = payload.find('\0');
+    res.file_name = payload.substr(0, name_end);
+    total = 0;
+    if (std::string::npos != name_end && name_end + 1 < payload.length()) {
+        const char* size_str = payload.c_str() + name_end + 1;
+        total = static_cast<uint64_t>(std::strtoull(size_str, nullptr, 10));
+    }
+}
+
+block_status receive_ymodem_header(connection& conn, const xmodem_options& opts, std::string& buf) {
+    for (uint32_t i = 0; i < opts.retries; i++) {
+        write_byte(conn, CRC_START);
+        uint8_t blk = 0;
+        auto st = read_block(conn, true, opts, buf, blk);
+        if (block_status::ok == st && 0 == blk) {
+            write_byte(conn, ACK);
+            return st;
+        } else if (block_status::cancel == st) {
+            throw_canceled();
+        }
+    }
+    cancel_transfer(conn);
+    throw support::exception(TRACEMSG("YMODEM header receive error," +
+            " attempts: [" + sl::support::to_string(opts.retries) + "]"));
+}
+
+} // namespace
+
+xmodem_result xmodem_send(connection& conn, const std::string& path,
+        const xmodem_options& opts, xmodem_progress_fun progress) {
+    // firmware images are small enough to be kept in memory
+    auto src = sl::tinydir::file_source(path);
+    auto sink = sl::io::string_sink();
+    sl::io::copy_all(src, sink);
+    const std::string& data = sink.get_string();
+    uint64_t total = static_cast<uint64_t>(data.length());
+
+    auto res = xmodem_result();
+    auto frame = std::string();
+    frame.reserve(block_size_long + 5);
+    bool crc = wait_for_receiver(conn, opts);
+    bool ymodem = xmodem_protocol::ymodem == opts.protocol;
+    if (ymodem) {
+        res.file_name = sl::utils::strip_parent_dir(path);
+        auto header = res.file_name;
+        header.push_back('\0');
+        header.append(sl::support::to_string(total));
+        size_t size = header.length() < block_size_short ? block_size_short : block_size_long;
+        header.resize(std::min(header.length(), size));
+        make_frame(frame, 0, header.data(), header.length(), size, true, '\0');
+        send_frame(conn, frame, 0, opts);
+        crc = wait_for_receiver(conn, opts);
+    }
+
+    // data blocks
+    size_t size = block_size(opts.protocol);
+    uint8_t blk = 1;
+    size_t offset = 0;
+    while (offset < data.length()) {
+        size_t len = std::min(size, data.length() - offset);
+        // last short block of YMODEM does not need to be padded to 1K
+        size_t frame_size = ymodem && len <= block_size_short ? block_size_short : size;
+        make_frame(frame, blk, data.data() + offset, len, frame_size, crc, CPMEOF);
+        send_frame(conn, frame, blk, opts);
+        offset += len;
+        blk += 1;
+        res.bytes_count = offset;
+        if (progress) {
+            progress(res.bytes_count, total);
+        }
+    }
+    send_eot(conn, opts);
+
+    // end of batch
+    if (ymodem) {
+        wait_for_receiver(conn, opts);
+        auto empty = std::string();
+        make_frame(frame, 0, empty.data(), 0, block_size_short, true, '\0');
+        send_frame(conn, frame, 0, opts);
+    }
+    return res;
+}
+
+xmodem_result xmodem_receive(connection& conn, const std::string& path,
+        const xmodem_options& opts, xmodem_progress_fun progress) {
+    auto sink = sl::tinydir::file_sink(path);
+    auto res = xmodem_result();
+    auto buf = std::string();
+    buf.reserve(block_size_long + 4);
+    bool ymodem = xmodem_protocol::ymodem == opts.protocol;
+    uint64_t total = 0;
+    if (ymodem) {
+        receive_ymodem_header(conn, opts, buf);
+        parse_ymodem_header(buf, res, total);
+        if (res.file_name.empty()) {
+            // empty batch
+            return res;
+        }
+    }
+
+    // data blocks
+    bool crc = true;
+    bool started = false;
+    bool eot_nacked = false;
+    uint8_t expected = 1;
+    uint32_t errors = 0;
+    uint32_t crc_attempts = 0;
+    write_byte(conn, CRC_START);
+    for (;;) {
+        uint8_t blk = 0;
+        auto st = read_block(conn, crc, opts, buf, blk);
+        if (block_status::ok == st) {
+            if (expected == blk) {
+                size_t len = buf.length();
+                if (total > 0) {
+                    len = static_cast<size_t>(std::min(static_cast<uint64_t>(len), total - res.bytes_count));
+                }
+                sl::io::write_all(sink, {buf.data(), len});
+                res.bytes_count += len;
+                expected += 1;
+                started = true;
+                errors = 0;
+                write_byte(conn, ACK);
+                if (progress) {
+                    progress(res.bytes_count, total);
+                }
+            } else if (static_cast<uint8_t>(expected - 1) == blk) {
+                // our ACK was lost, sender repeats the block
+                write_byte(conn, ACK);
+            } else {
+                cancel_transfer(conn);
+                throw support::exception(TRACEMSG("XMODEM block sequence error," +
+                        " expected: [" + sl::support::to_string(static_cast<int>(expected)) + "]," +
+                        " received: [" + sl::support::to_string(static_cast<int>(blk)) + "]"));
+            }
+            continue;
+        }
+        if (block_status::eot == st) {
+            if (ymodem && !eot_nacked) {
+                eot_nacked = true;
+                write_byte(conn, NAK);
+                continue;
+            }
+            write_byte(conn, ACK);
+            break;
+        }
+        if (block_status::cancel == st) {
+            throw_canceled();
+        }
+        // sender may not support CRC, retries are counted after the fallback to checksum
+        if (!started && crc && !ymodem) {
+            crc_attempts += 1;
+            if (crc_attempts >= crc_start_attempts) {
+                crc = false;
+            }
+            write_byte(conn, crc ? CRC_START : NAK);
+            continue;
+        }
+        // timeout or broken block
+        errors += 1;
+        if (errors >= opts.retries) {
+            cancel_transfer(conn);
+            throw support::exception(TRACEMSG("XMODEM block receive error," +
+                    " block: [" + sl::support::to_string(static_cast<int>(expected)) + "]," +
+                    " attempts: [" + sl::support::to_string(errors) + "]"));
+        }
+        if (!started) {
+            write_byte(conn, crc ? CRC_START : NAK);
+        } else {
+            write_byte(conn, NAK);
+        }
+    }
+    sink.flush();
+
+    // end of batch, only single file is supported
+    if (ymodem) {
+        auto name = res.file_name;
+        uint64_t next_total = 0;
+        receive_ymodem_header(conn, opts, buf);
+        parse_ymodem_header(buf, res, next_total);
+        if (!res.file_name.empty()) {
+            cancel_transfer(conn);
+            throw support::exception(TRACEMSG("YMODEM batch with multiple files is not supported," +
+                    " second file: [" + res.file_name + "]"));
+        }
+        res.file_name = name;
+    }
+    return res;
+}
+
+} // namespace
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   xmodem.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 12:25 PM
+ */
+
+#ifndef WILTON_SERIAL_XMODEM_HPP
+#define WILTON_SERIAL_XMODEM_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "staticlib/config.hpp"
+
+#include "connection.hpp"
+#include "xmodem_protocol.hpp"
+
+namespace wilton {
+namespace serial {
+
+/**
+ * Progress callback, receives the number of bytes transferred
+ * and the total number of bytes (zero if unknown)
+ */
+typedef std::function<void(uint64_t, uint64_t)> xmodem_progress_fun;
+
+class xmodem_options {
+public:
+    xmodem_protocol protocol = xmodem_protocol::xmodem_1k;
+    // max number of attempts for each block
+    uint32_t retries = 10;
+    // max time to wait for each response from the other side
+    uint32_t timeout_millis = 10000;
+};
+
+class xmodem_result {
+public:
+    // file name reported by YMODEM sender, empty for XMODEM
+    std::string file_name;
+    uint64_t bytes_count = 0;
+};
+
+/**
+ * Sends the specified file over XMODEM/YMODEM, waits for the receiver to start
+ *
+ * @param conn connection
+ * @param path path to the file
+ * @param opts transfer options
+ * @param progress progress callback, may be empty
+ * @return transfer result
+ */
+xmodem_result xmodem_send(connection& conn, const std::string& path,
+        const xmodem_options& opts, xmodem_progress_fun progress);
+
+/**
+ * Receives a single file over XMODEM/YMODEM and writes it to the specified path,
+ * for XMODEM the trailing padding is written as is
+ *
+ * @param conn connection
+ * @param path path to the destination file, file is overwritten if exists
+ * @param opts transfer options
+ * @param progress progress callback, may be empty
+ * @return transfer result
+ */
+xmodem_result xmodem_receive(connection& conn, const std::string& path,
+        const xmodem_options& opts, xmodem_progress_fun progress);
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_XMODEM_HPP */
+
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   xmodem_protocol.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 12:20 PM
+ */
+
+#include <string>
+
+#include "staticlib/support.hpp"
+
+#include "wilton/support/exception.hpp"
+
+#ifndef WILTON_SERIAL_XMODEM_PROTOCOL_HPP
+#define WILTON_SERIAL_XMODEM_PROTOCOL_HPP
+
+namespace wilton {
+namespace serial {
+
+enum class xmodem_protocol {
+    xmodem,
+    xmodem_1k,
+    ymodem
+};
+
+inline std::string stringify_xmodem_protocol(xmodem_protocol pr) {
+    switch (pr) {
+    case xmodem_protocol::xmodem: return "XMODEM";
+    case xmodem_protocol::xmodem_1k: return "XMODEM_1K";
+    case xmodem_protocol::ymodem: return "YMODEM";
+    default: return "UNKNOWN";
+    }
+}
+
+inline xmodem_protocol make_xmodem_protocol(const std::string& st) {
+    if ("XMODEM" == st) {
+        return xmodem_protocol::xmodem;
+    } else if ("XMODEM_1K" == st) {
+        return xmodem_protocol::xmodem_1k;
+    } else if ("YMODEM" == st) {
+        return xmodem_protocol::ymodem;
+    } else throw support::exception(TRACEMSG("Invalid XMODEM protocol: [" + st + "]"));
+}
+
+} // namespace
+}
+
+#endif /* WILTON_SERIAL_XMODEM_PROTOCOL_HPP */
+
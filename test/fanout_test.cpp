@@ -0,0 +1,217 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * File:   fanout_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 11:58 PM
+ */
+
+#include "fanout.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "staticlib/config/assert.hpp"
+
+#include "pty_pair.hpp"
+
+namespace { // anonymous
+
+using namespace wilton::serial;
+
+const uint32_t capacity = 64;
+
+std::string make_stream(size_t length) {
+    auto res = std::string();
+    for (size_t i = 0; i < length; i++) {
+        res.push_back(static_cast<char>('a' + i % 26));
+    }
+    return res;
+}
+
+std::string read_some(fanout& fan, uint32_t id, uint32_t timeout_millis) {
+    auto buf = std::string();
+    buf.resize(256);
+    uint32_t read = fan.read(id, {std::addressof(buf.front()), buf.length()}, timeout_millis);
+    buf.resize(read);
+    return buf;
+}
+
+std::string read_exact(fanout& fan, uint32_t id, size_t length) {
+    auto res = std::string();
+    while (res.length() < length) {
+        auto chunk = read_some(fan, id, 1000);
+        slassert(!chunk.empty());
+        res.append(chunk);
+    }
+    return res;
+}
+
+uint64_t elapsed_millis(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count());
+}
+
+void test_two_subscribers() {
+    pty_pair pty;
+    auto conn = open_pty_connection(pty.first(), 500);
+    auto peer = open_pty_connection(pty.second(), 500);
+    std::mutex io_mutex;
+    fanout fan(conn, io_mutex, capacity);
+    uint32_t first = fan.subscribe(overflow_policy::drop_oldest);
+    uint32_t second = fan.subscribe(overflow_policy::drop_oldest);
+    slassert(first != second);
+    peer.write({"hello", 5});
+    slassert("hello" == read_exact(fan, first, 5));
+    slassert("hello" == read_exact(fan, second, 5));
+    slassert(read_some(fan, first, 100).empty());
+    fan.close();
+}
+
+void test_drop_oldest() {
+    pty_pair pty;
+    auto conn = open_pty_connection(pty.first(), 500);
+    auto peer = open_pty_connection(pty.second(), 500);
+    std::mutex io_mutex;
+    fanout fan(conn, io_mutex, capacity);
+    uint32_t fast = fan.subscribe(overflow_policy::drop_oldest);
+    uint32_t slow = fan.subscribe(overflow_policy::drop_oldest);
+    auto data = make_stream(200);
+    peer.write({data.data(), data.length()});
+    slassert(data == read_exact(fan, fast, data.length()));
+    // lagging subscriber gets only the data still in the ring
+    auto tail = read_some(fan, slow, 100);
+    slassert(data.substr(data.length() - capacity) == tail);
+    auto st = fan.status(slow);
+    slassert(data.length() - capacity == static_cast<size_t>(st.getattr("bytesDropped").as_int64()));
+    slassert(0 == st.getattr("bytesPending").as_int64());
+    fan.close();
+}
+
+void test_block() {
+    pty_pair pty;
+    auto conn = open_pty_connection(pty.first(), 500);
+    auto peer = open_pty_connection(pty.second(), 500);
+    std::mutex io_mutex;
+    fanout fan(conn, io_mutex, capacity);
+    uint32_t fast = fan.subscribe(overflow_policy::drop_oldest);
+    uint32_t blocking = fan.subscribe(overflow_policy::block);
+    auto data = make_stream(200);
+    peer.write({data.data(), data.length()});
+    // port is not read while the blocking subscriber lags by the whole ring
+    auto fast_data = std::string();
+    for (;;) {
+        auto chunk = read_some(fan, fast, 200);
+        if (chunk.empty()) {
+            break;
+        }
+        fast_data.append(chunk);
+    }
+    slassert(data.substr(0, capacity) == fast_data);
+    // consuming lagged data lets the port reads proceed
+    auto blocking_data = std::string();
+    while (fast_data.length() < data.length() || blocking_data.length() < data.length()) {
+        if (blocking_data.length() < data.length()) {
+            blocking_data.append(read_some(fan, blocking, 200));
+        }
+        if (fast_data.length() < data.length()) {
+            fast_data.append(read_some(fan, fast, 200));
+        }
+    }
+    slassert(data == fast_data);
+    slassert(data == blocking_data);
+    slassert(0 == fan.status(blocking).getattr("bytesDropped").as_int64());
+    fan.close();
+}
+
+void test_slot_reuse() {
+    pty_pair pty;
+    auto conn = open_pty_connection(pty.first(), 500);
+    auto peer = open_pty_connection(pty.second(), 500);
+    std::mutex io_mutex;
+    fanout fan(conn, io_mutex, capacity);
+    slassert(!fan.has_subscribers());
+    uint32_t first = fan.subscribe(overflow_policy::drop_oldest);
+    uint32_t second = fan.subscribe(overflow_policy::block);
+    peer.write({"abc", 3});
+    slassert("abc" == read_exact(fan, second, 3));
+
+    // slot of the unsubscribed one is reused, new subscriber gets only the new data
+    fan.unsubscribe(first);
+    bool thrown = false;
+    try {
+        fan.status(first);
+    } catch (const std::exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    uint32_t third = fan.subscribe(overflow_policy::drop_oldest);
+    slassert(first == third);
+    peer.write({"def", 3});
+    slassert("def" == read_exact(fan, third, 3));
+    slassert("def" == read_exact(fan, second, 3));
+
+    fan.unsubscribe(second);
+    fan.unsubscribe(third);
+    slassert(!fan.has_subscribers());
+    slassert(first == fan.subscribe(overflow_policy::block));
+    fan.close();
+}
+
+void test_write_during_read() {
+    pty_pair pty;
+    auto conn = open_pty_connection(pty.first(), 500);
+    auto peer = open_pty_connection(pty.second(), 500);
+    std::mutex io_mutex;
+    fanout fan(conn, io_mutex, capacity);
+    uint32_t id = fan.subscribe(overflow_policy::drop_oldest);
+    auto th = std::thread([&fan, id] {
+        slassert(read_some(fan, id, 1000).empty());
+    });
+    // port read holds the I/O mutex only for a short slice
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> guard{io_mutex};
+        conn.write({"xyz", 3});
+    }
+    slassert(elapsed_millis(start) < 500);
+    th.join();
+    slassert("xyz" == peer.read(3));
+    fan.close();
+}
+
+} // namespace
+
+int main() {
+    try {
+        test_two_subscribers();
+        test_drop_oldest();
+        test_block();
+        test_slot_reuse();
+        test_write_during_read();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * File:   hex_codec_bench.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 5:20 PM
+ */
+
+#include "hex_codec.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+namespace { // anonymous
+
+using namespace wilton::serial;
+
+// bytes processed per measured case
+const size_t bytes_per_case = 16 * 1024 * 1024;
+
+// keeps the results alive so the loops are not optimized out
+size_t checksum = 0;
+
+std::string make_data(size_t size) {
+    auto res = std::string();
+    auto rng = std::mt19937(static_cast<uint32_t>(size));
+    for (size_t i = 0; i < size; i++) {
+        res.push_back(static_cast<char>(rng()));
+    }
+    return res;
+}
+
+// encoding path used by wilton::support::make_hex_buffer
+std::string staticlib_sink_encode(const std::string& data) {
+    auto src = sl::io::array_source(data.data(), data.length());
+    auto sink = sl::io::string_sink();
+    {
+        auto hex = sl::io::make_hex_sink(sink);
+        sl::io::copy_all(src, hex);
+    }
+    return std::move(sink.get_string());
+}
+
+void measure(const std::string& label, size_t size, std::function<size_t()> fun) {
+    size_t iterations = std::max(bytes_per_case / size, static_cast<size_t>(1));
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        checksum += fun();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    double mbps = static_cast<double>(iterations * size) / static_cast<double>(micros > 0 ? micros : 1);
+    std::cout << std::left << std::setw(28) << label <<
+            " size: " << std::setw(8) << size <<
+            " MB/s: " << std::fixed << std::setprecision(1) << mbps << std::endl;
+}
+
+void check_equal(const std::string& data) {
+    auto hex = hex_encode({data.data(), data.length()});
+    slassert(sl::io::string_to_hex(data) == hex);
+    slassert(staticlib_sink_encode(data) == hex);
+    slassert(sl::io::string_from_hex(hex) == hex_decode({hex.data(), hex.length()}));
+    slassert(data == hex_decode({hex.data(), hex.length()}));
+}
+
+void bench(size_t size) {
+    auto data = make_data(size);
+    auto hex = sl::io::string_to_hex(data);
+    check_equal(data);
+
+    measure("hex_encode", size, [&data] {
+        return hex_encode({data.data(), data.length()}).length();
+    });
+    auto dest = std::string();
+    dest.resize(data.length() * 2);
+    measure("hex_encode_into", size, [&data, &dest] {
+        return hex_encode_into({data.data(), data.length()}, {std::addressof(dest.front()), dest.length()});
+    });
+    measure("sl::io::string_to_hex", size, [&data] {
+        return sl::io::string_to_hex(data).length();
+    });
+    measure("sl::io::hex_sink", size, [&data] {
+        return staticlib_sink_encode(data).length();
+    });
+    measure("hex_decode", size, [&hex] {
+        return hex_decode({hex.data(), hex.length()}).length();
+    });
+    measure("sl::io::string_from_hex", size, [&hex] {
+        return sl::io::string_from_hex(hex).length();
+    });
+}
+
+} // namespace
+
+int main() {
+    try {
+        // odd sizes exercise the scalar tails
+        for (size_t size : {1, 15, 17, 33, 63, 65, 1000}) {
+            check_equal(make_data(size));
+        }
+        for (size_t size : {16, 256, 4096, 65536}) {
+            bench(size);
+        }
+        std::cout << "checksum: " << checksum << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
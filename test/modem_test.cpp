@@ -0,0 +1,145 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * File:   modem_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 11:36 PM
+ */
+
+#include "modem_monitor.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include "staticlib/config/assert.hpp"
+
+#include "pty_pair.hpp"
+
+// Pseudo-terminals have no modem lines, TIOCMGET and TIOCGICOUNT fail
+// with ENOTTY on them, so line changes cannot be simulated here;
+// these tests check that the waits fail promptly instead of polling
+// until the timeout, and that nothing keeps running after them.
+
+namespace { // anonymous
+
+using namespace wilton::serial;
+
+uint64_t elapsed_millis(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count());
+}
+
+void test_wait_unsupported() {
+    pty_pair pty;
+    auto conn = open_pty_connection(pty.first(), 500);
+    auto peer = open_pty_connection(pty.second(), 500);
+    std::mutex io_mutex;
+    for (size_t i = 0; i < 3; i++) {
+        auto start = std::chrono::steady_clock::now();
+        bool thrown = false;
+        try {
+            conn.wait_modem_change({modem_line::cts, modem_line::dsr}, 2000, io_mutex);
+        } catch (const std::exception& e) {
+            thrown = std::string(e.what()).find("TIOCMGET") != std::string::npos;
+        }
+        slassert(thrown);
+        slassert(elapsed_millis(start) < 1000);
+    }
+    // port stays usable after the failed waits
+    conn.write({"ping", 4});
+    slassert("ping" == peer.read(4));
+}
+
+void test_wait_output_line() {
+    pty_pair pty;
+    auto conn = open_pty_connection(pty.first(), 500);
+    std::mutex io_mutex;
+    bool thrown = false;
+    try {
+        conn.wait_modem_change({modem_line::rts}, 100, io_mutex);
+    } catch (const std::exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_wait_takes_io_lock() {
+    pty_pair pty;
+    auto conn = open_pty_connection(pty.first(), 500);
+    std::mutex io_mutex;
+    auto start = std::chrono::steady_clock::now();
+    auto th = std::thread([&io_mutex] {
+        std::lock_guard<std::mutex> guard{io_mutex};
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    // lines are not polled while the port is used by the other thread
+    bool thrown = false;
+    try {
+        conn.wait_modem_change({modem_line::cts}, 2000, io_mutex);
+    } catch (const std::exception&) {
+        thrown = true;
+    }
+    th.join();
+    slassert(thrown);
+    slassert(elapsed_millis(start) >= 200);
+}
+
+void test_send_break() {
+    pty_pair pty;
+    auto conn = open_pty_connection(pty.first(), 500);
+    auto start = std::chrono::steady_clock::now();
+    conn.send_break(50);
+    slassert(elapsed_millis(start) >= 50);
+}
+
+void test_poll_interval_config() {
+    auto conf = serial_config(sl::json::load(std::string(
+            "{\"port\": \"/dev/null\", \"modemPollMillis\": 25}")));
+    slassert(25 == conf.modem_poll_millis);
+    slassert(25 == conf.to_json().getattr("modemPollMillis").as_int64());
+    slassert(10 == serial_config().modem_poll_millis);
+    bool thrown = false;
+    try {
+        auto invalid = serial_config(sl::json::load(std::string(
+                "{\"port\": \"/dev/null\", \"modemPollMillis\": 0}")));
+        (void) invalid;
+    } catch (const std::exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+} // namespace
+
+int main() {
+    try {
+        test_wait_unsupported();
+        test_wait_output_line();
+        test_wait_takes_io_lock();
+        test_send_break();
+        test_poll_interval_config();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
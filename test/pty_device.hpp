@@ -0,0 +1,98 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * File:   pty_device.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 12:20 AM
+ */
+
+#ifndef WILTON_SERIAL_TEST_PTY_DEVICE_HPP
+#define WILTON_SERIAL_TEST_PTY_DEVICE_HPP
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "staticlib/config/assert.hpp"
+
+/**
+ * Pseudo-terminal published under the link path, closing
+ * both ends hangs up the connection opened on it;
+ * re-creating the device under the same path simulates a replug
+ */
+class pty_device {
+    std::string link_path;
+    int master = -1;
+    int slave = -1;
+
+public:
+    explicit pty_device(const std::string& link_path) :
+    link_path(link_path) {
+        struct termios tty;
+        ::cfmakeraw(std::addressof(tty));
+        char name[128];
+        if (0 != ::openpty(std::addressof(master), std::addressof(slave), name, std::addressof(tty), nullptr)) {
+            throw std::runtime_error("'openpty' error");
+        }
+        std::remove(link_path.c_str());
+        if (0 != ::symlink(name, link_path.c_str())) {
+            throw std::runtime_error("'symlink' error");
+        }
+    }
+
+    ~pty_device() {
+        unplug();
+    }
+
+    pty_device(const pty_device&) = delete;
+
+    pty_device& operator=(const pty_device&) = delete;
+
+    void unplug() {
+        // link may already point to the new device
+        if (-1 == master) {
+            return;
+        }
+        ::close(slave);
+        slave = -1;
+        ::close(master);
+        master = -1;
+        std::remove(link_path.c_str());
+    }
+
+    void send(const std::string& str) {
+        auto res = ::write(master, str.data(), str.length());
+        slassert(static_cast<ssize_t>(str.length()) == res);
+    }
+
+    std::string receive(size_t length) {
+        auto res = std::string();
+        res.resize(length);
+        auto read = ::read(master, std::addressof(res.front()), length);
+        slassert(read > 0);
+        res.resize(static_cast<size_t>(read));
+        return res;
+    }
+};
+
+#endif /* WILTON_SERIAL_TEST_PTY_DEVICE_HPP */
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * File:   pty_pair.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 4:10 PM
+ */
+
+#ifndef WILTON_SERIAL_TEST_PTY_PAIR_HPP
+#define WILTON_SERIAL_TEST_PTY_PAIR_HPP
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <poll.h>
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "connection.hpp"
+#include "serial_config.hpp"
+
+/**
+ * Two pseudo-terminals bridged by a relay thread, slave ends act
+ * as two ends of a null-modem cable
+ */
+class pty_pair {
+    int master1 = -1;
+    int slave1 = -1;
+    int master2 = -1;
+    int slave2 = -1;
+    std::string name1;
+    std::string name2;
+    std::atomic<bool> stop_flag;
+    std::thread relay;
+
+public:
+    pty_pair() :
+    stop_flag(false) {
+        open_pty(master1, slave1, name1);
+        open_pty(master2, slave2, name2);
+        relay = std::thread([this] {
+            run();
+        });
+    }
+
+    ~pty_pair() {
+        stop_flag.store(true);
+        relay.join();
+        ::close(slave1);
+        ::close(slave2);
+        ::close(master1);
+        ::close(master2);
+    }
+
+    pty_pair(const pty_pair&) = delete;
+
+    pty_pair& operator=(const pty_pair&) = delete;
+
+    const std::string& first() const {
+        return name1;
+    }
+
+    const std::string& second() const {
+        return name2;
+    }
+
+private:
+    static void open_pty(int& master, int& slave, std::string& name) {
+        struct termios tty;
+        ::cfmakeraw(std::addressof(tty));
+        char buf[128];
+        if (0 != ::openpty(std::addressof(master), std::addressof(slave), buf, std::addressof(tty), nullptr)) {
+            throw std::runtime_error("'openpty' error");
+        }
+        name = std::string(buf);
+    }
+
+    void run() {
+        char buf[4096];
+        while (!stop_flag.load()) {
+            struct pollfd fds[2];
+            fds[0].fd = master1;
+            fds[0].events = POLLIN;
+            fds[1].fd = master2;
+            fds[1].events = POLLIN;
+            if (::poll(fds, 2, 50) <= 0) {
+                continue;
+            }
+            relay_from(fds[0], master2, buf, sizeof(buf));
+            relay_from(fds[1], master1, buf, sizeof(buf));
+        }
+    }
+
+    static void relay_from(const struct pollfd& src, int dest, char* buf, size_t buf_len) {
+        if (0 == (src.revents & POLLIN)) {
+            return;
+        }
+        auto read = ::read(src.fd, buf, buf_len);
+        for (ssize_t written = 0; written < read;) {
+            auto res = ::write(dest, buf + written, read - written);
+            if (res <= 0) {
+                break;
+            }
+            written += res;
+        }
+    }
+};
+
+inline wilton::serial::connection open_pty_connection(const std::string& port, uint32_t timeout_millis) {
+    auto conf = wilton::serial::serial_config();
+    conf.port = port;
+    conf.baud_rate = 115200;
+    conf.timeout_millis = timeout_millis;
+    return wilton::serial::connection(std::move(conf));
+}
+
+#endif /* WILTON_SERIAL_TEST_PTY_PAIR_HPP */
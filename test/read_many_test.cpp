@@ -0,0 +1,153 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * File:   read_many_test.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 12:34 AM
+ */
+
+#include "read_many.hpp"
+
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "staticlib/config/assert.hpp"
+
+#include "pty_device.hpp"
+#include "pty_pair.hpp"
+
+namespace { // anonymous
+
+using namespace wilton::serial;
+
+const std::string link_path = "read_many_test_tty";
+
+connection open_device_connection(bool reconnect) {
+    auto conf = serial_config();
+    conf.port = link_path;
+    conf.timeout_millis = 500;
+    conf.reconnect = reconnect;
+    conf.reconnect_backoff_min_millis = 50;
+    conf.reconnect_backoff_max_millis = 200;
+    return connection(std::move(conf));
+}
+
+uint64_t elapsed_millis(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count());
+}
+
+void test_keyed_result() {
+    pty_pair pty;
+    auto live = open_pty_connection(pty.first(), 500);
+    auto peer = open_pty_connection(pty.second(), 500);
+    auto dev = std::unique_ptr<pty_device>(new pty_device(link_path));
+    auto lost = open_device_connection(true);
+    auto conns = std::vector<connection*>{std::addressof(live), std::addressof(lost)};
+    auto keys = std::vector<std::string>{"1", "2"};
+
+    // ports without data are not listed
+    peer.write({"hi", 2});
+    auto res = read_many(conns, keys, 64, 1000);
+    slassert(1 == res.as_object().size());
+    slassert("6869" == res.getattr("1").getattr("dataHex").as_string());
+
+    // positional result lists all ports
+    dev->send("ab");
+    res = read_many(conns, std::vector<std::string>(), 64, 1000);
+    slassert(2 == res.as_array().size());
+    slassert(res.as_array()[0].getattr("dataHex").as_string().empty());
+    slassert("6162" == res.as_array()[1].getattr("dataHex").as_string());
+
+    // lost port does not extend the wait, and does not spin
+    dev->unplug();
+    auto start = std::chrono::steady_clock::now();
+    auto cpu_start = std::clock();
+    res = read_many(conns, keys, 64, 300);
+    slassert(res.as_object().empty());
+    slassert(elapsed_millis(start) >= 290);
+    slassert(elapsed_millis(start) < 600);
+    slassert(-1 == lost.poll_fd());
+    slassert(std::clock() - cpu_start < CLOCKS_PER_SEC / 10);
+
+    // data on the live port is returned while the other one is lost
+    peer.write({"cd", 2});
+    start = std::chrono::steady_clock::now();
+    res = read_many(conns, keys, 64, 1000);
+    slassert(elapsed_millis(start) < 300);
+    slassert("6364" == res.getattr("1").getattr("dataHex").as_string());
+    slassert(res.getattr("2").json_type() == sl::json::type::nullt);
+
+    // device is back, it is reopened by the reads
+    dev.reset(new pty_device(link_path));
+    start = std::chrono::steady_clock::now();
+    while (-1 == lost.poll_fd() && elapsed_millis(start) < 2000) {
+        read_many(conns, keys, 64, 100);
+    }
+    slassert(-1 != lost.poll_fd());
+    dev->send("ef");
+    res = read_many(conns, keys, 64, 1000);
+    slassert(1 == res.as_object().size());
+    slassert("6566" == res.getattr("2").getattr("dataHex").as_string());
+}
+
+void test_error_keyed() {
+    pty_pair pty;
+    auto live = open_pty_connection(pty.first(), 500);
+    auto dev = std::unique_ptr<pty_device>(new pty_device(link_path));
+    auto lost = open_device_connection(false);
+    auto conns = std::vector<connection*>{std::addressof(live), std::addressof(lost)};
+    auto keys = std::vector<std::string>{"1", "2"};
+    dev->unplug();
+    auto start = std::chrono::steady_clock::now();
+    auto res = read_many(conns, keys, 64, 1000);
+    slassert(elapsed_millis(start) < 500);
+    slassert(1 == res.as_object().size());
+    slassert(!res.getattr("2").getattr("error").as_string().empty());
+}
+
+void test_keys_count() {
+    pty_pair pty;
+    auto live = open_pty_connection(pty.first(), 500);
+    auto conns = std::vector<connection*>{std::addressof(live)};
+    bool thrown = false;
+    try {
+        read_many(conns, {"1", "2"}, 64, 0);
+    } catch (const std::exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+} // namespace
+
+int main() {
+    try {
+        test_keyed_result();
+        test_error_keyed();
+        test_keys_count();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * File:   readline_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 4:32 PM
+ */
+
+#include "line_reader.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+#include "frame_parser.hpp"
+#include "pty_pair.hpp"
+
+namespace { // anonymous
+
+using namespace wilton::serial;
+
+void write_str(connection& conn, const std::string& str) {
+    conn.write({str.data(), str.length()});
+}
+
+std::string xor8(const std::string& payload) {
+    uint8_t res = 0;
+    for (char ch : payload) {
+        res ^= static_cast<uint8_t>(ch);
+    }
+    return std::string(1, static_cast<char>(res));
+}
+
+void test_read_line() {
+    pty_pair pty;
+    auto src = open_pty_connection(pty.first(), 300);
+    auto dest = open_pty_connection(pty.second(), 300);
+    write_str(src, "abc\r\ndef\nghi");
+    slassert("abc" == dest.read_line());
+    slassert("def" == dest.read_line());
+    // no terminator before the timeout
+    slassert("ghi" == dest.read_line());
+    slassert("" == dest.read_line());
+
+    auto big = std::string(1000, 'x');
+    write_str(src, big + "\nyy\n");
+    slassert(big == dest.read_line());
+    slassert("yy" == dest.read_line());
+}
+
+void test_read_lines() {
+    pty_pair pty;
+    auto src = open_pty_connection(pty.first(), 300);
+    auto dest = open_pty_connection(pty.second(), 300);
+    write_str(src, "l1\r\nl2\nl3\npart");
+    auto lines = std::vector<std::string>();
+    // lines may arrive in several chunks
+    while (lines.size() < 3) {
+        auto batch = read_lines(dest, 10, 1000);
+        slassert(!batch.empty());
+        lines.insert(lines.end(), batch.begin(), batch.end());
+    }
+    slassert(3 == lines.size());
+    slassert("l1" == lines[0]);
+    slassert("l2" == lines[1]);
+    slassert("l3" == lines[2]);
+    // incomplete line is kept for the next read
+    slassert(dest.has_unread());
+    slassert(read_lines(dest, 10, 100).empty());
+    write_str(src, "ial\n");
+    auto tail = read_lines(dest, 10, 1000);
+    slassert(1 == tail.size());
+    slassert("partial" == tail[0]);
+    // max lines limit
+    write_str(src, "a\nb\nc\n");
+    auto limited = std::vector<std::string>();
+    while (limited.size() < 3) {
+        auto batch = read_lines(dest, 1, 1000);
+        slassert(1 == batch.size());
+        limited.push_back(batch[0]);
+    }
+    slassert("a" == limited[0]);
+    slassert("c" == limited[2]);
+}
+
+void test_frames() {
+    pty_pair pty;
+    auto src = open_pty_connection(pty.first(), 300);
+    auto dest = open_pty_connection(pty.second(), 300);
+    auto parser = make_frame_parser("STX_ETX_XOR", 64);
+    write_str(src, "zz\x02" "hello" + xor8("hello") + "\x03" +
+            "\x02" "bad" "Q\x03" +
+            "\x02" "ok" + xor8("ok") + "\x03");
+    auto buf = std::string();
+    auto frames = std::vector<sl::io::span<const char>>();
+    auto payloads = std::vector<std::string>();
+    char chunk[16];
+    while (payloads.size() < 2) {
+        auto read = dest.read_available({chunk, sizeof(chunk)}, 1000);
+        slassert(read > 0);
+        buf.append(chunk, read);
+        frames.clear();
+        size_t consumed = parser->parse({buf.data(), buf.length()}, 10, frames);
+        for (auto& fr : frames) {
+            payloads.emplace_back(fr.data(), fr.size());
+        }
+        buf.erase(0, consumed);
+    }
+    slassert(2 == payloads.size());
+    slassert("hello" == payloads[0]);
+    slassert("ok" == payloads[1]);
+    slassert(parser->bytes_skipped() > 0);
+}
+
+} // namespace
+
+int main() {
+    try {
+        test_read_line();
+        test_read_lines();
+        test_frames();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
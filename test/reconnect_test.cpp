@@ -0,0 +1,143 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * File:   reconnect_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 4:51 PM
+ */
+
+#include "connection.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "staticlib/config/assert.hpp"
+
+#include "pty_device.hpp"
+
+namespace { // anonymous
+
+using namespace wilton::serial;
+
+// stable path for the device, re-pointed to simulate a replug
+const std::string link_path = "reconnect_test_tty";
+
+serial_config make_config(bool reconnect) {
+    auto conf = serial_config();
+    conf.port = link_path;
+    conf.timeout_millis = 3000;
+    conf.reconnect = reconnect;
+    conf.reconnect_backoff_min_millis = 50;
+    conf.reconnect_backoff_max_millis = 400;
+    return conf;
+}
+
+uint64_t elapsed_millis(std::chrono::steady_clock::time_point start) {
+    auto dur = std::chrono::steady_clock::now() - start;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(dur).count());
+}
+
+void test_reconnect_on_replug() {
+    auto dev = std::unique_ptr<pty_device>(new pty_device(link_path));
+    auto conn = connection(make_config(true));
+    dev->send("a1\n");
+    slassert("a1" == conn.read_line());
+
+    // device disappears and comes back under the same path
+    dev->unplug();
+    auto th = std::thread([&dev] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        dev.reset(new pty_device(link_path));
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        dev->send("b2\n");
+    });
+    auto line = conn.read_line();
+    th.join();
+    slassert("b2" == line);
+
+    // writes go to the new device
+    slassert(3 == conn.write({"xyz", 3}));
+    slassert("xyz" == dev->receive(3));
+
+    // device is gone for good, read ends with the timeout
+    dev->unplug();
+    auto start = std::chrono::steady_clock::now();
+    slassert(conn.read(4).empty());
+    slassert(elapsed_millis(start) >= 2000);
+}
+
+void test_backoff_across_reads() {
+    auto dev = std::unique_ptr<pty_device>(new pty_device(link_path));
+    auto conn = connection(make_config(true));
+    dev->send("a1\n");
+    slassert("a1" == conn.read_line());
+
+    // short reads while the device is gone, attempts are done at about
+    // 50, 150, 350 and 750ms after the loss, next one at 1150ms
+    dev->unplug();
+    auto buf = std::string();
+    buf.resize(16);
+    auto start = std::chrono::steady_clock::now();
+    while (elapsed_millis(start) < 900) {
+        slassert(0 == conn.read_available({std::addressof(buf.front()), buf.length()}, 10));
+    }
+    slassert(-1 == conn.poll_fd());
+
+    // device is back, but is not reopened before the scheduled attempt
+    dev.reset(new pty_device(link_path));
+    auto replugged = std::chrono::steady_clock::now();
+    while (-1 == conn.poll_fd() && elapsed_millis(replugged) < 2000) {
+        conn.read_available({std::addressof(buf.front()), buf.length()}, 10);
+    }
+    slassert(-1 != conn.poll_fd());
+    slassert(elapsed_millis(replugged) >= 150);
+    dev->send("b2\n");
+    slassert("b2" == conn.read_line());
+}
+
+void test_no_reconnect() {
+    auto dev = std::unique_ptr<pty_device>(new pty_device(link_path));
+    auto conn = connection(make_config(false));
+    dev->send("a1\n");
+    slassert("a1" == conn.read_line());
+    dev->unplug();
+    bool thrown = false;
+    try {
+        conn.read(4);
+    } catch (const std::exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+} // namespace
+
+int main() {
+    try {
+        test_reconnect_on_replug();
+        test_backoff_across_reads();
+        test_no_reconnect();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,217 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   shm_ring_test.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 3:20 AM
+ */
+
+#include "wilton/wilton_serial.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/json.hpp"
+
+#include "pty_pair.hpp"
+
+namespace { // anonymous
+
+const size_t ring_capacity = 64;
+const size_t stream_size = 1000;
+
+// reader side of the ring, maps the segment by name
+class mapped_segment {
+    int fd = -1;
+    size_t size = 0;
+    char* mapped = nullptr;
+
+public:
+    mapped_segment(const std::string& name, size_t size) :
+    size(size) {
+        this->fd = ::shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0) {
+            throw std::runtime_error("'shm_open' error, name: [" + name + "]");
+        }
+        void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (MAP_FAILED == ptr) {
+            ::close(fd);
+            throw std::runtime_error("'mmap' error, name: [" + name + "]");
+        }
+        this->mapped = static_cast<char*>(ptr);
+    }
+
+    ~mapped_segment() {
+        ::munmap(mapped, size);
+        ::close(fd);
+    }
+
+    mapped_segment(const mapped_segment&) = delete;
+
+    mapped_segment& operator=(const mapped_segment&) = delete;
+
+    const char* data() const {
+        return mapped;
+    }
+};
+
+// frees the error, message is returned for the checks
+std::string take_error(char* err) {
+    if (nullptr == err) {
+        return std::string();
+    }
+    auto res = std::string(err);
+    wilton_free(err);
+    return res;
+}
+
+void check_call(char* err) {
+    auto msg = take_error(err);
+    if (!msg.empty()) {
+        throw std::runtime_error(msg);
+    }
+}
+
+wilton_Serial* open_port(const std::string& port) {
+    auto conf = sl::json::value({
+        { "port", port },
+        { "baudRate", 115200 },
+        { "timeoutMillis", 500 }
+    }).dumps();
+    wilton_Serial* ser = nullptr;
+    check_call(wilton_Serial_open(std::addressof(ser), conf.c_str(), static_cast<int>(conf.length())));
+    return ser;
+}
+
+sl::json::value start_ring(wilton_Serial* ser) {
+    auto conf = sl::json::value({
+        { "capacity", static_cast<uint32_t>(ring_capacity) }
+    }).dumps();
+    char* info = nullptr;
+    int info_len = 0;
+    check_call(wilton_Serial_shm_start(ser, conf.c_str(), static_cast<int>(conf.length()),
+            std::addressof(info), std::addressof(info_len)));
+    auto res = sl::json::load({info, info_len});
+    wilton_free(info);
+    return res;
+}
+
+void write_all(wilton_Serial* ser, const std::string& data) {
+    for (size_t written = 0; written < data.length();) {
+        int len = 0;
+        check_call(wilton_Serial_write(ser, data.data() + written,
+                static_cast<int>(data.length() - written), std::addressof(len)));
+        written += static_cast<size_t>(len);
+    }
+}
+
+std::string read_direct(wilton_Serial* ser, int len) {
+    char* data = nullptr;
+    int data_len = 0;
+    check_call(wilton_Serial_read(ser, len, std::addressof(data), std::addressof(data_len)));
+    auto res = std::string(data, static_cast<size_t>(data_len));
+    wilton_free(data);
+    return res;
+}
+
+void test_wrap_around() {
+    pty_pair pty;
+    auto ser = open_port(pty.first());
+    auto peer = open_port(pty.second());
+    auto info = start_ring(ser);
+    auto header_size = static_cast<size_t>(info.getattr("headerSize").as_int64());
+    slassert(ring_capacity == static_cast<size_t>(info.getattr("capacity").as_int64()));
+    mapped_segment seg(info.getattr("name").as_string(), static_cast<size_t>(info.getattr("size").as_int64()));
+    slassert(0 == std::memcmp(seg.data(), "WSRB", 4));
+
+    // stream is larger than the ring, the rest waits in the driver queue
+    auto expected = std::string();
+    for (size_t i = 0; i < stream_size; i++) {
+        expected.push_back(static_cast<char>(i % 251));
+    }
+    write_all(peer, expected);
+
+    auto received = std::string();
+    long long read_pos = 0;
+    long long write_pos = 0;
+    int consumed = 0;
+    auto finish = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (received.length() < stream_size && std::chrono::steady_clock::now() < finish) {
+        check_call(wilton_Serial_shm_advance(ser, consumed, 500,
+                std::addressof(read_pos), std::addressof(write_pos)));
+        slassert(write_pos - read_pos <= static_cast<long long>(ring_capacity));
+        for (long long pos = read_pos; pos < write_pos; pos++) {
+            received.push_back(seg.data()[header_size + static_cast<size_t>(pos) % ring_capacity]);
+        }
+        consumed = static_cast<int>(write_pos - read_pos);
+    }
+    slassert(expected == received);
+    slassert(static_cast<size_t>(write_pos) == stream_size);
+
+    check_call(wilton_Serial_shm_stop(ser));
+    check_call(wilton_Serial_close(peer));
+    check_call(wilton_Serial_close(ser));
+}
+
+void test_direct_io_rejected() {
+    pty_pair pty;
+    auto ser = open_port(pty.first());
+    auto peer = open_port(pty.second());
+    start_ring(ser);
+
+    char* data = nullptr;
+    int data_len = 0;
+    auto err = take_error(wilton_Serial_read(ser, 16, std::addressof(data), std::addressof(data_len)));
+    slassert(std::string::npos != err.find(
+            "Direct reads are not allowed while the port is used by: [shared ring]"));
+    int written = 0;
+    err = take_error(wilton_Serial_write(ser, "ping", 4, std::addressof(written)));
+    slassert(std::string::npos != err.find(
+            "Direct writes are not allowed while the port is used by: [shared ring]"));
+
+    // port is released to the direct calls after the ring is stopped
+    check_call(wilton_Serial_shm_stop(ser));
+    write_all(ser, "ping");
+    slassert("ping" == read_direct(peer, 4));
+    write_all(peer, "pong");
+    slassert("pong" == read_direct(ser, 4));
+
+    check_call(wilton_Serial_close(peer));
+    check_call(wilton_Serial_close(ser));
+}
+
+} // namespace
+
+int main() {
+    try {
+        test_wrap_around();
+        test_direct_io_rejected();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,44 @@
+# Copyright 2017, alex at staticlibs.net
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# checks that the library has stapsdt notes for all the probes,
+# usage: cmake -DREADELF=<path> -DLIBRARY=<path> -P usdt_probes.cmake
+
+execute_process ( COMMAND ${READELF} -n ${LIBRARY}
+        OUTPUT_VARIABLE _notes
+        RESULT_VARIABLE _res )
+if ( NOT _res EQUAL 0 )
+    message ( FATAL_ERROR "'readelf' error, library: [${LIBRARY}], code: [${_res}]" )
+endif ( )
+
+if ( NOT _notes MATCHES "NT_STAPSDT" OR NOT _notes MATCHES "Provider: wilton_serial" )
+    message ( FATAL_ERROR "No 'wilton_serial' stapsdt notes found, library: [${LIBRARY}]" )
+endif ( )
+
+foreach ( _probe
+        open
+        close
+        read
+        write
+        poll_enter
+        poll_exit
+        timeout
+        api_open
+        api_close
+        api_read
+        api_write )
+    if ( NOT _notes MATCHES "Name: ${_probe}\n" )
+        message ( FATAL_ERROR "Probe not found: [${_probe}], library: [${LIBRARY}]" )
+    endif ( )
+endforeach ( )
@@ -0,0 +1,197 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * File:   xmodem_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 4:18 PM
+ */
+
+#include "xmodem.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#include "staticlib/config/assert.hpp"
+
+#include "pty_pair.hpp"
+
+namespace { // anonymous
+
+using namespace wilton::serial;
+
+const std::string src_path = "xmodem_test_src.bin";
+const std::string dest_path = "xmodem_test_dest.bin";
+
+std::string read_file(const std::string& path) {
+    std::ifstream stream(path, std::ios::binary);
+    std::stringstream ss;
+    ss << stream.rdbuf();
+    return ss.str();
+}
+
+void write_file(const std::string& path, const std::string& data) {
+    std::ofstream stream(path, std::ios::binary);
+    stream << data;
+}
+
+void transfer(xmodem_protocol protocol, size_t size) {
+    auto data = std::string();
+    auto rng = std::mt19937(static_cast<uint32_t>(size));
+    for (size_t i = 0; i < size; i++) {
+        data.push_back(static_cast<char>(rng()));
+    }
+    write_file(src_path, data);
+    std::remove(dest_path.c_str());
+
+    pty_pair pty;
+    auto sender = open_pty_connection(pty.first(), 500);
+    auto receiver = open_pty_connection(pty.second(), 500);
+    auto opts = xmodem_options();
+    opts.protocol = protocol;
+    opts.timeout_millis = 2000;
+
+    auto received = xmodem_result();
+    auto receive_error = std::string();
+    auto th = std::thread([&] {
+        try {
+            received = xmodem_receive(receiver, dest_path, opts, nullptr);
+        } catch (const std::exception& e) {
+            receive_error = e.what();
+        }
+    });
+    auto sent = xmodem_result();
+    auto send_error = std::string();
+    try {
+        sent = xmodem_send(sender, src_path, opts, nullptr);
+    } catch (const std::exception& e) {
+        send_error = e.what();
+    }
+    th.join();
+    if (!send_error.empty() || !receive_error.empty()) {
+        std::cout << "protocol: [" << stringify_xmodem_protocol(protocol) << "]," <<
+                " size: [" << size << "]\n" << send_error << receive_error << std::endl;
+    }
+    slassert(send_error.empty());
+    slassert(receive_error.empty());
+
+    auto out = read_file(dest_path);
+    if (xmodem_protocol::ymodem == protocol) {
+        // file size is sent in header block
+        slassert(data == out);
+        slassert(src_path == received.file_name);
+    } else {
+        // padded up to the block size
+        slassert(out.length() >= data.length());
+        slassert(data == out.substr(0, data.length()));
+        slassert(received.file_name.empty());
+    }
+    slassert(sent.bytes_count >= data.length());
+    slassert(received.bytes_count >= data.length());
+}
+
+void test_xmodem() {
+    for (size_t size : {0, 1, 127, 128, 1000, 5000}) {
+        transfer(xmodem_protocol::xmodem, size);
+    }
+}
+
+void test_xmodem_1k() {
+    for (size_t size : {0, 1, 1023, 1024, 5000, 70000}) {
+        transfer(xmodem_protocol::xmodem_1k, size);
+    }
+}
+
+void test_ymodem() {
+    for (size_t size : {0, 1, 1024, 5000, 70000}) {
+        transfer(xmodem_protocol::ymodem, size);
+    }
+}
+
+void test_checksum_sender() {
+    // sender ignores 'C' requests and only answers NAK with checksum blocks
+    std::remove(dest_path.c_str());
+    pty_pair pty;
+    auto sender = open_pty_connection(pty.first(), 500);
+    auto receiver = open_pty_connection(pty.second(), 500);
+    auto opts = xmodem_options();
+    opts.protocol = xmodem_protocol::xmodem;
+    opts.retries = 2;
+    opts.timeout_millis = 100;
+    auto data = std::string(128, 'x');
+
+    auto received = xmodem_result();
+    auto receive_error = std::string();
+    auto th = std::thread([&] {
+        try {
+            received = xmodem_receive(receiver, dest_path, opts, nullptr);
+        } catch (const std::exception& e) {
+            receive_error = e.what();
+        }
+    });
+    auto send_error = std::string();
+    try {
+        bool nak = false;
+        for (size_t i = 0; !nak && i < 20; i++) {
+            nak = "\x15" == sender.read(1);
+        }
+        slassert(nak);
+        auto block = std::string("\x01\x01\xfe");
+        block.append(data);
+        uint8_t sum = 0;
+        for (char ch : data) {
+            sum = static_cast<uint8_t>(sum + static_cast<uint8_t>(ch));
+        }
+        block.push_back(static_cast<char>(sum));
+        sender.write({block.data(), block.length()});
+        slassert("\x06" == sender.read(1));
+        sender.write({"\x04", 1});
+        slassert("\x06" == sender.read(1));
+    } catch (const std::exception& e) {
+        send_error = e.what();
+    }
+    th.join();
+    if (!send_error.empty() || !receive_error.empty()) {
+        std::cout << send_error << receive_error << std::endl;
+    }
+    slassert(send_error.empty());
+    slassert(receive_error.empty());
+    slassert(data == read_file(dest_path));
+    slassert(128 == received.bytes_count);
+}
+
+} // namespace
+
+int main() {
+    try {
+        test_xmodem();
+        test_xmodem_1k();
+        test_ymodem();
+        test_checksum_sender();
+        std::remove(src_path.c_str());
+        std::remove(dest_path.c_str());
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}